@@ -0,0 +1,115 @@
+// Throughput of CsvLoader against a std::getline + std::stoi parser on the same input.
+//
+//   csv_throughput [rows] [repeats]
+//
+// Both parsers read the same in-memory text and fill the same SoAVector, the best of `repeats`
+// runs is reported in GB/s of input. The checksums must match.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <CsvLoader.hpp>
+#include <SoAVector.hpp>
+#include <Span.hpp>
+
+enum class Side : std::uint8_t { Buy, Sell };
+
+struct Tick {
+    std::uint64_t time;
+    std::int32_t price;
+    std::int32_t quantity;
+    Side side;
+};
+
+std::string MakeInput(std::size_t rows) {
+    std::mt19937_64 random(42);
+    std::string text;
+    text.reserve(rows * 32);
+    std::uint64_t time = 1'700'000'000'000;
+    for (std::size_t i = 0; i < rows; ++i) {
+        time += random() % 1000;
+        text += std::to_string(time);
+        text += ',';
+        text += std::to_string(static_cast<std::int32_t>(random() % 2'000'000) - 1'000'000);
+        text += ',';
+        text += std::to_string(random() % 10'000);
+        text += random() % 2 == 0 ? ",Buy\n" : ",Sell\n";
+    }
+    return text;
+}
+
+void LoadCsv(const std::string& text, SoAVector<Tick>& ticks) {
+    CsvLoader<Tick> loader(ticks);
+    // Feed in blocks, as a reader streaming from a file would
+    constexpr std::size_t kBlock = std::size_t{1} << 20;
+    for (std::size_t offset = 0; offset < text.size(); offset += kBlock) {
+        loader.Feed(Span<const char>(text.data() + offset, std::min(kBlock, text.size() - offset)));
+    }
+    loader.Finish();
+}
+
+void LoadGetline(const std::string& text, SoAVector<Tick>& ticks) {
+    std::istringstream input(text);
+    std::string line;
+    std::string value;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        Tick tick{};
+        std::getline(fields, value, ',');
+        tick.time = std::stoull(value);
+        std::getline(fields, value, ',');
+        tick.price = std::stoi(value);
+        std::getline(fields, value, ',');
+        tick.quantity = std::stoi(value);
+        std::getline(fields, value, ',');
+        tick.side = value == "Buy" ? Side::Buy : Side::Sell;
+        ticks.PushBack(tick);
+    }
+}
+
+std::uint64_t Checksum(const SoAVector<Tick>& ticks) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < ticks.Size(); ++i) {
+        sum += ticks.Column<0>()[i] ^ static_cast<std::uint64_t>(ticks.Column<1>()[i]);
+        sum += static_cast<std::uint64_t>(ticks.Column<2>()[i]) * (static_cast<int>(ticks.Column<3>()[i]) + 1);
+    }
+    return sum;
+}
+
+template <class Load>
+std::uint64_t Measure(const char* name, const std::string& text, int repeats, Load load) {
+    double best = 0;
+    std::uint64_t checksum = 0;
+    for (int run = 0; run < repeats; ++run) {
+        SoAVector<Tick> ticks;
+        auto start = std::chrono::steady_clock::now();
+        load(text, ticks);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, static_cast<double>(text.size()) / elapsed.count() / 1e9);
+        checksum = Checksum(ticks);
+    }
+    std::printf("%-10s %8.3f GB/s  checksum %016llx\n", name, best, static_cast<unsigned long long>(checksum));
+    return checksum;
+}
+
+int main(int argc, char** argv) {
+    std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    std::string text = MakeInput(rows);
+    std::printf("%zu rows, %.1f MB\n", rows, static_cast<double>(text.size()) / 1e6);
+
+    std::uint64_t csv = Measure("CsvLoader", text, repeats, LoadCsv);
+    std::uint64_t baseline = Measure("getline", text, repeats, LoadGetline);
+    if (csv != baseline) {
+        std::fprintf(stderr, "checksums differ\n");
+        return 1;
+    }
+}
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Generates one translation unit per (facility, size) for the build-cost benchmark.
+
+Every unit forces the facility to be fully evaluated at the given size and
+exports a few values so that the object file reflects what a real user pays for.
+"""
+
+import argparse
+import pathlib
+
+TYPE_LIST_SIZES = [16, 64, 256, 1024]
+ENUM_SIZES = [16, 64, 256, 1024]
+DESCRIBE_SIZES = [4, 8, 16, 32, 64, 128]
+
+
+def type_lists_unit(size):
+    items = ", ".join(f"Int<{i}>" for i in range(size))
+    return f"""#include <cstddef>
+#include <type_lists.hpp>
+
+template <int I>
+struct Int {{
+    static constexpr int Value = I;
+}};
+
+template <class T>
+struct Twice {{
+    static constexpr int Value = 2 * T::Value;
+}};
+
+template <class T>
+struct IsEven {{
+    static constexpr bool Value = T::Value % 2 == 0;
+}};
+
+template <class L, class R>
+using Sum = Int<L::Value + R::Value>;
+
+template <class... Ts>
+constexpr std::size_t Count(type_tuples::TTuple<Ts...>) {{
+    return sizeof...(Ts);
+}}
+
+using List = type_lists::FromTuple<type_tuples::TTuple<{items}>>;
+
+extern const std::size_t bench_mapped = Count(type_lists::ToTuple<type_lists::Map<Twice, List>>{{}});
+extern const std::size_t bench_filtered = Count(type_lists::ToTuple<type_lists::Filter<IsEven, List>>{{}});
+extern const std::size_t bench_reversed = Count(type_lists::ToTuple<type_lists::Reverse<List>>{{}});
+extern const int bench_folded = type_lists::Foldl<Sum, Int<0>, List>::Value;
+"""
+
+
+def enumerator_traits_unit(size):
+    # Enumerators are spread over the whole range so that every candidate value
+    # is probed and about one in four of them names an enumerator
+    items = ",\n    ".join(f"Item{i} = {i * 4 - size}" for i in range(size // 2))
+    return f"""#include <cstddef>
+#include <string_view>
+#include <EnumeratorTraits.hpp>
+
+enum class Bench : int {{
+    {items}
+}};
+
+using Traits = EnumeratorTraits<Bench, {size}>;
+
+extern const std::size_t bench_size = Traits::size();
+extern const Bench bench_last = Traits::at(Traits::size() - 1);
+extern const std::string_view bench_last_name = Traits::nameAt(Traits::size() - 1);
+"""
+
+
+def describe_unit(size):
+    fields = "\n    ".join(f"int field{i};" for i in range(size))
+    return f"""#include <cstddef>
+#include <reflect.hpp>
+
+struct Bench {{
+    {fields}
+}};
+
+using Description = Describe<Bench>;
+
+extern const std::size_t bench_num_fields = Description::num_fields;
+
+int& BenchLastField(Bench& object) {{
+    return Description::Get<Description::num_fields - 1>(object);
+}}
+"""
+
+
+FACILITIES = {
+    "type_lists": (TYPE_LIST_SIZES, type_lists_unit),
+    "EnumeratorTraits": (ENUM_SIZES, enumerator_traits_unit),
+    "Describe": (DESCRIBE_SIZES, describe_unit),
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--out", required=True, type=pathlib.Path, help="directory for the generated sources")
+    args = parser.parse_args()
+
+    args.out.mkdir(parents=True, exist_ok=True)
+    for facility, (sizes, make_unit) in FACILITIES.items():
+        for size in sizes:
+            path = args.out / f"{facility}_{size}.cpp"
+            source = make_unit(size)
+            # Leave unchanged sources alone so their timestamps stay stable
+            if not path.exists() or path.read_text() != source:
+                path.write_text(source)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Compiles the generated benchmark units and writes a JSON report of their build cost.
+
+For every unit the report records the compiler front-end time, the total wall
+time, the peak resident memory of the compiler and the size of the object file.
+Front-end time comes from -ftime-trace under Clang and -ftime-report under GCC;
+peak memory is the maximum resident set of the compiler's process tree, the
+value /usr/bin/time reports. Pass --baseline to print the change against an
+earlier report.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+GCC_FRONTEND_PHASES = ("phase parsing", "phase lang. deferred")
+
+
+def compiler_kind(compiler):
+    version = subprocess.run([compiler, "--version"], capture_output=True, text=True, check=True).stdout
+    return ("clang" if "clang" in version else "gcc"), version.splitlines()[0]
+
+
+def run(command):
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stderr=subprocess.PIPE, text=True)
+    stderr = process.stderr.read()
+    _, status, usage = os.wait4(process.pid, 0)
+    wall = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode(status)
+    if process.returncode != 0:
+        sys.exit(f"{' '.join(command)} failed:\n{stderr}")
+    # ru_maxrss is in KiB on Linux
+    return wall, usage.ru_maxrss, stderr
+
+
+def clang_frontend_seconds(trace_path):
+    events = json.loads(trace_path.read_text())["traceEvents"]
+    for event in events:
+        if event.get("name") == "Total Frontend":
+            return event["dur"] / 1e6
+    return None
+
+
+def gcc_frontend_seconds(time_report):
+    total = None
+    for line in time_report.splitlines():
+        name, _, columns = line.partition(":")
+        if name.strip() in GCC_FRONTEND_PHASES:
+            # usr, sys and wall columns, each followed by a percentage
+            wall = float(re.findall(r"(\d+\.\d+)", columns)[2])
+            total = (total or 0.0) + wall
+    return total
+
+
+def measure(compiler, kind, flags, source, build_dir):
+    obj = build_dir / (source.stem + ".o")
+    command = [compiler, *flags, "-c", str(source), "-o", str(obj)]
+    command.append("-ftime-trace" if kind == "clang" else "-ftime-report")
+    wall, peak_kib, stderr = run(command)
+    if kind == "clang":
+        frontend = clang_frontend_seconds(obj.with_suffix(".json"))
+    else:
+        frontend = gcc_frontend_seconds(stderr)
+    return {
+        "frontend_seconds": frontend,
+        "wall_seconds": round(wall, 3),
+        "peak_memory_kib": peak_kib,
+        "object_bytes": obj.stat().st_size,
+    }
+
+
+def print_comparison(results, baseline):
+    old = {(entry["facility"], entry["size"]): entry for entry in baseline["results"]}
+    print(f"{'unit':<24}{'wall s':>16}{'peak MiB':>18}{'object B':>20}")
+    for entry in results:
+        before = old.get((entry["facility"], entry["size"]))
+        cells = []
+        for key, scale, precision in (("wall_seconds", 1, 2), ("peak_memory_kib", 1024, 1), ("object_bytes", 1, 0)):
+            now = f"{entry[key] / scale:.{precision}f}"
+            cells.append(now if before is None else f"{before[key] / scale:.{precision}f}->{now}")
+        print(f"{entry['facility'] + '_' + str(entry['size']):<24}{cells[0]:>16}{cells[1]:>18}{cells[2]:>20}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--compiler", required=True)
+    parser.add_argument("--sources", required=True, type=pathlib.Path, help="directory written by generate.py")
+    parser.add_argument("--out", required=True, type=pathlib.Path, help="path of the JSON report")
+    parser.add_argument("--flag", action="append", default=[], help="compiler flag, may be repeated")
+    parser.add_argument("--include", action="append", default=[], help="include directory, may be repeated")
+    parser.add_argument("--repeat", type=int, default=1, help="compile each unit this many times and keep the fastest run")
+    parser.add_argument("--baseline", type=pathlib.Path, help="earlier report to compare against")
+    args = parser.parse_args()
+
+    kind, version = compiler_kind(args.compiler)
+    flags = args.flag + [f"-I{path}" for path in args.include]
+
+    results = []
+    with tempfile.TemporaryDirectory() as build_dir:
+        units = [(source, *source.stem.rpartition("_")[::2]) for source in args.sources.glob("*.cpp")]
+        for source, facility, size in sorted(units, key=lambda unit: (unit[1], int(unit[2]))):
+            runs = [measure(args.compiler, kind, flags, source, pathlib.Path(build_dir)) for _ in range(args.repeat)]
+            best = min(runs, key=lambda run: run["wall_seconds"])
+            results.append({"facility": facility, "size": int(size), **best})
+            print(f"{source.stem}: {best['wall_seconds']:.2f}s, {best['peak_memory_kib'] // 1024} MiB", flush=True)
+
+    report = {"compiler": version, "flags": args.flag, "results": results}
+    args.out.write_text(json.dumps(report, indent=2) + "\n")
+
+    if args.baseline is not None:
+        print_comparison(results, json.loads(args.baseline.read_text()))
+
+
+if __name__ == "__main__":
+    main()
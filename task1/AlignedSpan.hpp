@@ -0,0 +1,122 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+
+#include <Span.hpp>
+
+
+namespace detail {
+
+  // Alignment that is still guaranteed after moving `offset` bytes from an `align`-aligned address
+  constexpr std::size_t AlignmentAfter(std::size_t align, std::size_t offset) noexcept {
+    if (offset == 0) return align;
+    std::size_t offset_alignment = offset & (~offset + 1);
+    return offset_alignment < align ? offset_alignment : align;
+  }
+
+}  // namespace detail
+
+
+// Span whose data is known to be aligned to `align` bytes.
+// The alignment is checked on construction and passed to the compiler through std::assume_aligned,
+// so loops over the span can use aligned vector loads without a prologue.
+template <typename T, std::size_t extent = std::dynamic_extent, std::size_t align = alignof(T)>
+class AlignedSpan : public Span<T, extent> {
+  static_assert(std::has_single_bit(align), "Alignment must be a power of two");
+  static_assert(align >= alignof(T), "Alignment must be at least the alignment of the element type");
+
+  using Base = Span<T, extent>;
+
+public:
+  using typename Base::size_type;
+  using typename Base::pointer;
+  using typename Base::reference;
+  using typename Base::iterator;
+
+  static constexpr std::size_t alignment = align;
+
+  // Constructors
+
+  AlignedSpan() requires (extent == 0 || extent == std::dynamic_extent) = default;
+
+  explicit AlignedSpan(const Base& span) : Base(span) {
+    assert(IsAligned(span.Data()));
+  }
+
+  template <std::contiguous_iterator It>
+  AlignedSpan(It first, size_type count) : Base(first, count) {
+    assert(IsAligned(Base::Data()));
+  }
+
+  template <std::ranges::contiguous_range Range>
+  explicit AlignedSpan(Range&& range) : Base(std::forward<Range>(range)) {
+    assert(IsAligned(Base::Data()));
+  }
+
+  AlignedSpan(const AlignedSpan&) = default;
+
+  AlignedSpan& operator=(const AlignedSpan&) = default;
+
+  // Weaker alignment can always be assumed
+  template <std::size_t other_align>
+  requires (other_align < align && other_align >= alignof(T))
+  operator AlignedSpan<T, extent, other_align>() const {
+    return AlignedSpan<T, extent, other_align>(static_cast<const Base&>(*this));
+  }
+
+  static bool IsAligned(const T* data) noexcept {
+    return reinterpret_cast<std::uintptr_t>(data) % align == 0;
+  }
+
+  // Element access
+
+  reference operator[](size_type index) const {
+    return Data()[index];
+  }
+
+  pointer Data() const {
+    return std::assume_aligned<align>(Base::Data());
+  }
+
+  // Subviews
+
+  template <std::size_t Count>
+  AlignedSpan<T, Count, align> First() const {
+    return AlignedSpan<T, Count, align>(Data(), Count);
+  }
+
+  AlignedSpan<T, std::dynamic_extent, align> First(std::size_t Count) const {
+    return AlignedSpan<T, std::dynamic_extent, align>(Data(), Count);
+  }
+
+  // Alignment of the tail is only known when the extent is static
+  template <std::size_t Count>
+  auto Last() const {
+    if constexpr (extent != std::dynamic_extent) {
+      constexpr std::size_t tail_align = detail::AlignmentAfter(align, (extent - Count) * sizeof(T));
+      return AlignedSpan<T, Count, tail_align>(Data() + extent - Count, Count);
+    } else {
+      return AlignedSpan<T, Count, alignof(T)>(Data() + this->Size() - Count, Count);
+    }
+  }
+
+  AlignedSpan<T, std::dynamic_extent, alignof(T)> Last(std::size_t Count) const {
+    return AlignedSpan<T, std::dynamic_extent, alignof(T)>(Data() + this->Size() - Count, Count);
+  }
+
+  // Iterator methods
+
+  iterator begin() const {
+    return Data();
+  }
+
+  iterator end() const {
+    return Data() + this->Size();
+  }
+};
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <bits/iterator_concepts.h>
 #include <bits/ranges_base.h>
 #include <span>
@@ -10,9 +12,9 @@
 namespace detail {
 
   template <std::size_t extent>
-  class ExtentHolder {
+  class SpanExtentHolder {
   public:
-    [[gnu::always_inline]] ExtentHolder(std::size_t size) { assert(extent <= size); }
+    [[gnu::always_inline]] SpanExtentHolder(std::size_t size) { assert(extent <= size); }
 
     constexpr std::size_t GetExtent() const noexcept {
       return extent;
@@ -20,10 +22,10 @@ namespace detail {
   };
 
   template <>
-  class ExtentHolder<std::dynamic_extent> {
+  class SpanExtentHolder<std::dynamic_extent> {
     std::size_t extent_;
   public:
-    [[gnu::always_inline]] ExtentHolder(std::size_t size) : extent_(size) {
+    [[gnu::always_inline]] SpanExtentHolder(std::size_t size) : extent_(size) {
 
     }
 
@@ -33,13 +35,16 @@ namespace detail {
 
   };
 
+  template <typename T, std::size_t chunk_extent>
+  class SpanChunks;
+
 }  // namespace detail
 
 
 template <typename T, std::size_t extent = std::dynamic_extent>
-class Span : private detail::ExtentHolder<extent> {
+class Span : private detail::SpanExtentHolder<extent> {
 private:
-  using ExtentHolder = detail::ExtentHolder<extent>;
+  using ExtentHolder = detail::SpanExtentHolder<extent>;
 public:
   using element_type = T;
   using value_type = std::remove_cv_t<T>;
@@ -143,6 +148,27 @@ public:
     return Span<T, std::dynamic_extent>(Data() + Size() - Count, Count);
   }
 
+  // Blocking
+
+  // Consecutive blocks of Count elements, the incomplete last block is available as Remainder()
+  template <std::size_t Count>
+  detail::SpanChunks<T, Count> Chunks() const {
+    static_assert(Count != 0 && Count != std::dynamic_extent);
+    return detail::SpanChunks<T, Count>(Data(), Size() / Count, Count, Count, Size() % Count);
+  }
+
+  detail::SpanChunks<T, std::dynamic_extent> Chunks(std::size_t Count) const {
+    assert(Count != 0);
+    return detail::SpanChunks<T, std::dynamic_extent>(Data(), Size() / Count, Count, Count, Size() % Count);
+  }
+
+  // All subviews of Count consecutive elements
+  template <std::size_t Count>
+  detail::SpanChunks<T, Count> Windows() const {
+    static_assert(Count != 0 && Count != std::dynamic_extent);
+    return detail::SpanChunks<T, Count>(Data(), Size() < Count ? 0 : Size() - Count + 1, Count, 1, 0);
+  }
+
   // Iterator methods
 
   iterator begin() const {
@@ -183,6 +209,136 @@ private:
 };
 
 
+namespace detail {
+
+  // Range of `count` subviews of `chunk` elements each, starting `step` elements apart
+  template <typename T, std::size_t chunk_extent>
+  class SpanChunks {
+  public:
+    using value_type = Span<T, chunk_extent>;
+
+    class iterator {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Span<T, chunk_extent>;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+
+      iterator() = default;
+
+      iterator(T* data, std::size_t chunk, std::size_t step) : data_(data), chunk_(chunk), step_(step) {}
+
+      value_type operator*() const {
+        return value_type(data_, chunk_);
+      }
+
+      value_type operator[](difference_type n) const {
+        return value_type(data_ + n * step_, chunk_);
+      }
+
+      iterator& operator++() {
+        data_ += step_;
+        return *this;
+      }
+
+      iterator operator++(int) {
+        iterator copy = *this;
+        data_ += step_;
+        return copy;
+      }
+
+      iterator& operator--() {
+        data_ -= step_;
+        return *this;
+      }
+
+      iterator operator--(int) {
+        iterator copy = *this;
+        data_ -= step_;
+        return copy;
+      }
+
+      iterator& operator+=(difference_type n) {
+        data_ += n * step_;
+        return *this;
+      }
+
+      iterator& operator-=(difference_type n) {
+        data_ -= n * step_;
+        return *this;
+      }
+
+      friend iterator operator+(iterator it, difference_type n) {
+        return it += n;
+      }
+
+      friend iterator operator+(difference_type n, iterator it) {
+        return it += n;
+      }
+
+      friend iterator operator-(iterator it, difference_type n) {
+        return it -= n;
+      }
+
+      difference_type operator-(const iterator& other) const {
+        return (data_ - other.data_) / static_cast<difference_type>(step_);
+      }
+
+      bool operator==(const iterator& other) const {
+        return data_ == other.data_;
+      }
+
+      auto operator<=>(const iterator& other) const {
+        return data_ <=> other.data_;
+      }
+
+    private:
+      T* data_ = nullptr;
+      std::size_t chunk_ = 0;
+      std::size_t step_ = 1;
+    };
+
+    SpanChunks(T* data, std::size_t count, std::size_t chunk, std::size_t step, std::size_t remainder)
+      : data_(data), count_(count), chunk_(chunk), step_(step), remainder_(remainder) {
+
+    }
+
+    std::size_t Size() const {
+      return count_;
+    }
+
+    [[nodiscard]] bool empty() const {
+      return count_ == 0;
+    }
+
+    value_type operator[](std::size_t index) const {
+      return value_type(data_ + index * step_, chunk_);
+    }
+
+    // Elements not covered by any chunk
+    Span<T, std::dynamic_extent> Remainder() const {
+      return Span<T, std::dynamic_extent>(data_ + count_ * step_, remainder_);
+    }
+
+    iterator begin() const {
+      return iterator(data_, chunk_, step_);
+    }
+
+    iterator end() const {
+      return iterator(data_ + count_ * step_, chunk_, step_);
+    }
+
+  private:
+    T* data_;
+    std::size_t count_;
+    std::size_t chunk_;
+    std::size_t step_;
+    std::size_t remainder_;
+  };
+
+}  // namespace detail
+
+
 template <class It, class EndOrSize>
 Span( It, EndOrSize ) -> Span<std::remove_reference_t<std::iter_reference_t<It>>>;
 
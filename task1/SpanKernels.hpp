@@ -0,0 +1,380 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <Span.hpp>
+#include <AlignedSpan.hpp>
+
+// Reduction and search kernels over Span.
+//
+// Fixed-extent spans of up to kUnrollLimit elements are fully unrolled at compile time,
+// everything else goes through a vector loop picked at runtime (AVX2 if the CPU has it,
+// SSE2 otherwise; a plain scalar loop on other architectures).
+// For an AlignedSpan aligned at least to the vector width the unaligned head is not peeled
+// and the loops use aligned loads.
+// Note that vector Sum of floating point values reassociates the additions,
+// so the result may differ from the scalar one in the last bits.
+
+// 32-byte vectors never cross a function boundary by value: without -mavx that changes
+// the ABI and GCC warns about it at every call site. Helpers take and fill them by reference
+// and are always inlined into the AVX2 entry points.
+
+namespace detail::simd {
+
+  inline constexpr std::size_t kUnrollLimit = 64;
+
+  template <typename T>
+  concept Vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+  template <typename T, std::size_t bytes>
+  using Vec [[gnu::vector_size(bytes)]] = T;
+
+  // Lane type of the comparison result for T
+  template <typename T>
+  using MaskLane = std::conditional_t<sizeof(T) == 1, std::int8_t,
+                   std::conditional_t<sizeof(T) == 2, std::int16_t,
+                   std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+
+  template <typename T, std::size_t bytes, std::size_t align>
+  [[gnu::always_inline]] inline void Load(Vec<T, bytes>& result, const T* data) {
+    if constexpr (align >= bytes) {
+      __builtin_memcpy(&result, __builtin_assume_aligned(data, bytes), bytes);
+    } else {
+      __builtin_memcpy(&result, data, bytes);
+    }
+  }
+
+  template <typename T, std::size_t bytes>
+  [[gnu::always_inline]] inline void Splat(Vec<T, bytes>& result, T value) {
+    result = Vec<T, bytes>{} + value;
+  }
+
+  template <std::size_t bytes, typename Mask>
+  [[gnu::always_inline]] inline bool Any(const Mask& mask) {
+    Vec<std::uint64_t, bytes> words;
+    __builtin_memcpy(&words, &mask, bytes);
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < bytes / sizeof(std::uint64_t); ++i) {
+      result |= words[i];
+    }
+    return result != 0;
+  }
+
+  // Reduction operations, folding value into acc; V is a scalar or a vector
+
+  struct SumOp {
+    template <typename V>
+    [[gnu::always_inline]] static void Apply(V& acc, const V& value) {
+      acc = acc + value;
+    }
+  };
+
+  struct MinOp {
+    template <typename V>
+    [[gnu::always_inline]] static void Apply(V& acc, const V& value) {
+      acc = value < acc ? value : acc;
+    }
+  };
+
+  struct MaxOp {
+    template <typename V>
+    [[gnu::always_inline]] static void Apply(V& acc, const V& value) {
+      acc = acc < value ? value : acc;
+    }
+  };
+
+  // Scalar versions, also used for heads and tails of the vector loops
+
+  template <typename Op, typename T>
+  [[gnu::always_inline]] inline T ReduceScalar(const T* data, std::size_t size, T init) {
+    for (std::size_t i = 0; i < size; ++i) {
+      Op::Apply(init, data[i]);
+    }
+    return init;
+  }
+
+  template <typename T>
+  [[gnu::always_inline]] inline std::size_t FindScalar(const T* data, std::size_t size, T value) {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (data[i] == value) return i;
+    }
+    return size;
+  }
+
+  template <typename T>
+  [[gnu::always_inline]] inline std::size_t CountScalar(const T* data, std::size_t size, T value) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      count += data[i] == value;
+    }
+    return count;
+  }
+
+  // Number of leading elements to process one by one before data is aligned to `bytes`
+  template <typename T, std::size_t bytes, std::size_t align>
+  [[gnu::always_inline]] inline std::size_t HeadSize(const T* data, std::size_t size) {
+    if constexpr (align >= bytes) {
+      return 0;
+    }
+    std::size_t misalignment = reinterpret_cast<std::uintptr_t>(data) % bytes;
+    std::size_t head = misalignment == 0 || misalignment % sizeof(T) != 0 ? 0 : (bytes - misalignment) / sizeof(T);
+    return head < size ? head : size;
+  }
+
+  // Vector loops, `bytes` is the register width and `align` is the known alignment of data
+
+  template <std::size_t bytes, std::size_t align, typename Op, typename T>
+  [[gnu::always_inline]] inline T Reduce(const T* data, std::size_t size, T init) {
+    constexpr std::size_t lanes = bytes / sizeof(T);
+    std::size_t head = HeadSize<T, bytes, align>(data, size);
+    init = ReduceScalar<Op>(data, head, init);
+    data += head;
+    size -= head;
+    if (size < 2 * lanes) {
+      return ReduceScalar<Op>(data, size, init);
+    }
+
+    // Two accumulators to hide the latency of the reduction operation
+    Vec<T, bytes> acc0, acc1, block0, block1;
+    Load<T, bytes, align>(acc0, data);
+    Load<T, bytes, align>(acc1, data + lanes);
+    std::size_t i = 2 * lanes;
+    for (; i + 2 * lanes <= size; i += 2 * lanes) {
+      Load<T, bytes, align>(block0, data + i);
+      Load<T, bytes, align>(block1, data + i + lanes);
+      Op::Apply(acc0, block0);
+      Op::Apply(acc1, block1);
+    }
+    Op::Apply(acc0, acc1);
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      Op::Apply(init, static_cast<T>(acc0[lane]));
+    }
+    return ReduceScalar<Op>(data + i, size - i, init);
+  }
+
+  template <std::size_t bytes, std::size_t align, typename T>
+  [[gnu::always_inline]] inline std::size_t Find(const T* data, std::size_t size, T value) {
+    constexpr std::size_t lanes = bytes / sizeof(T);
+    std::size_t head = HeadSize<T, bytes, align>(data, size);
+    if (std::size_t pos = FindScalar(data, head, value); pos != head) {
+      return pos;
+    }
+    Vec<T, bytes> needle, block;
+    Splat<T, bytes>(needle, value);
+    std::size_t i = head;
+    for (; i + lanes <= size; i += lanes) {
+      Load<T, bytes, align>(block, data + i);
+      if (Any<bytes>(block == needle)) {
+        return i + FindScalar(data + i, lanes, value);
+      }
+    }
+    return i + FindScalar(data + i, size - i, value);
+  }
+
+  template <std::size_t bytes, std::size_t align, typename T>
+  [[gnu::always_inline]] inline std::size_t Count(const T* data, std::size_t size, T value) {
+    using Lane = MaskLane<T>;
+    constexpr std::size_t lanes = bytes / sizeof(T);
+    // Lane counters must be flushed before they overflow
+    constexpr std::size_t flush_period = static_cast<std::size_t>(std::numeric_limits<Lane>::max());
+
+    std::size_t head = HeadSize<T, bytes, align>(data, size);
+    std::size_t count = CountScalar(data, head, value);
+    Vec<T, bytes> needle, block;
+    Splat<T, bytes>(needle, value);
+    std::size_t i = head;
+    while (i + lanes <= size) {
+      Vec<Lane, bytes> counters{};
+      for (std::size_t iteration = 0; iteration < flush_period && i + lanes <= size; ++iteration, i += lanes) {
+        Load<T, bytes, align>(block, data + i);
+        counters -= (block == needle);
+      }
+      for (std::size_t lane = 0; lane < lanes; ++lane) {
+        count += static_cast<std::make_unsigned_t<Lane>>(counters[lane]);
+      }
+    }
+    return count + CountScalar(data + i, size - i, value);
+  }
+
+  // Runtime dispatch
+
+#if defined(__x86_64__) || defined(__i386__)
+
+  inline bool HasAvx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+  }
+
+  template <std::size_t align, typename Op, typename T>
+  [[gnu::target("avx2")]] T ReduceAvx2(const T* data, std::size_t size, T init) {
+    return Reduce<32, align, Op>(data, size, init);
+  }
+
+  template <std::size_t align, typename Op, typename T>
+  T ReduceSse2(const T* data, std::size_t size, T init) {
+    return Reduce<16, align, Op>(data, size, init);
+  }
+
+  template <std::size_t align, typename T>
+  [[gnu::target("avx2")]] std::size_t FindAvx2(const T* data, std::size_t size, T value) {
+    return Find<32, align>(data, size, value);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t FindSse2(const T* data, std::size_t size, T value) {
+    return Find<16, align>(data, size, value);
+  }
+
+  template <std::size_t align, typename T>
+  [[gnu::target("avx2")]] std::size_t CountAvx2(const T* data, std::size_t size, T value) {
+    return Count<32, align>(data, size, value);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t CountSse2(const T* data, std::size_t size, T value) {
+    return Count<16, align>(data, size, value);
+  }
+
+  template <std::size_t align, typename Op, typename T>
+  T DispatchReduce(const T* data, std::size_t size, T init) {
+    return HasAvx2() ? ReduceAvx2<align, Op>(data, size, init) : ReduceSse2<align, Op>(data, size, init);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t DispatchFind(const T* data, std::size_t size, T value) {
+    return HasAvx2() ? FindAvx2<align>(data, size, value) : FindSse2<align>(data, size, value);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t DispatchCount(const T* data, std::size_t size, T value) {
+    return HasAvx2() ? CountAvx2<align>(data, size, value) : CountSse2<align>(data, size, value);
+  }
+
+#else
+
+  template <std::size_t align, typename Op, typename T>
+  T DispatchReduce(const T* data, std::size_t size, T init) {
+    return ReduceScalar<Op>(data, size, init);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t DispatchFind(const T* data, std::size_t size, T value) {
+    return FindScalar(data, size, value);
+  }
+
+  template <std::size_t align, typename T>
+  std::size_t DispatchCount(const T* data, std::size_t size, T value) {
+    return CountScalar(data, size, value);
+  }
+
+#endif
+
+  // Fully unrolled versions for small compile-time extents
+
+  template <typename Op, typename T, std::size_t... I>
+  [[gnu::always_inline]] inline T ReduceUnrolled(const T* data, T init, std::index_sequence<I...>) {
+    (Op::Apply(init, data[I]), ...);
+    return init;
+  }
+
+  template <typename T, std::size_t... I>
+  [[gnu::always_inline]] inline std::size_t FindUnrolled(const T* data, T value, std::index_sequence<I...>) {
+    std::size_t result = sizeof...(I);
+    ((result = result == sizeof...(I) && data[I] == value ? I : result), ...);
+    return result;
+  }
+
+  template <typename T, std::size_t... I>
+  [[gnu::always_inline]] inline std::size_t CountUnrolled(const T* data, T value, std::index_sequence<I...>) {
+    return (std::size_t{0} + ... + static_cast<std::size_t>(data[I] == value));
+  }
+
+  template <std::size_t extent>
+  inline constexpr bool kUnroll = extent != std::dynamic_extent && extent <= kUnrollLimit;
+
+  // Spans accepted by the kernels, with the alignment they guarantee
+
+  template <typename S>
+  struct KernelSpanTraits;
+
+  template <typename T, std::size_t extent>
+  struct KernelSpanTraits<Span<T, extent>> {
+    using ValueType = std::remove_cv_t<T>;
+    static constexpr std::size_t kExtent = extent;
+    static constexpr std::size_t kAlign = alignof(T);
+  };
+
+  template <typename T, std::size_t extent, std::size_t align>
+  struct KernelSpanTraits<AlignedSpan<T, extent, align>> {
+    using ValueType = std::remove_cv_t<T>;
+    static constexpr std::size_t kExtent = extent;
+    static constexpr std::size_t kAlign = align;
+  };
+
+  template <typename S>
+  concept KernelSpan = Vectorizable<typename KernelSpanTraits<S>::ValueType>;
+
+  template <typename S>
+  using ValueType = typename KernelSpanTraits<S>::ValueType;
+
+  template <typename Op, KernelSpan S>
+  [[gnu::always_inline]] inline ValueType<S> Reduce(const S& span, ValueType<S> init) {
+    using Traits = KernelSpanTraits<S>;
+    if constexpr (kUnroll<Traits::kExtent>) {
+      return ReduceUnrolled<Op>(span.Data(), init, std::make_index_sequence<Traits::kExtent>());
+    } else {
+      return DispatchReduce<Traits::kAlign, Op, ValueType<S>>(span.Data(), span.Size(), init);
+    }
+  }
+
+}  // namespace detail::simd
+
+
+// Kernels
+
+template <detail::simd::KernelSpan S>
+detail::simd::ValueType<S> Sum(const S& span) {
+  return detail::simd::Reduce<detail::simd::SumOp>(span, detail::simd::ValueType<S>{});
+}
+
+// The span must not be empty
+template <detail::simd::KernelSpan S>
+detail::simd::ValueType<S> Min(const S& span) {
+  assert(!span.empty());
+  return detail::simd::Reduce<detail::simd::MinOp>(span, span.Front());
+}
+
+// The span must not be empty
+template <detail::simd::KernelSpan S>
+detail::simd::ValueType<S> Max(const S& span) {
+  assert(!span.empty());
+  return detail::simd::Reduce<detail::simd::MaxOp>(span, span.Front());
+}
+
+// Returns index of the first element equal to value, or Size() if there is none
+template <detail::simd::KernelSpan S>
+std::size_t Find(const S& span, detail::simd::ValueType<S> value) {
+  using Traits = detail::simd::KernelSpanTraits<S>;
+  if constexpr (detail::simd::kUnroll<Traits::kExtent>) {
+    return detail::simd::FindUnrolled(span.Data(), value, std::make_index_sequence<Traits::kExtent>());
+  } else {
+    return detail::simd::DispatchFind<Traits::kAlign, detail::simd::ValueType<S>>(span.Data(), span.Size(), value);
+  }
+}
+
+template <detail::simd::KernelSpan S>
+std::size_t Count(const S& span, detail::simd::ValueType<S> value) {
+  using Traits = detail::simd::KernelSpanTraits<S>;
+  if constexpr (detail::simd::kUnroll<Traits::kExtent>) {
+    return detail::simd::CountUnrolled(span.Data(), value, std::make_index_sequence<Traits::kExtent>());
+  } else {
+    return detail::simd::DispatchCount<Traits::kAlign, detail::simd::ValueType<S>>(span.Data(), span.Size(), value);
+  }
+}
@@ -0,0 +1,483 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include <Slice.hpp>
+
+
+namespace detail::bits {
+
+  inline constexpr std::size_t kWordBits = 64;
+
+  constexpr std::uint64_t LowMask(std::size_t count) noexcept {
+    return count >= kWordBits ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+  }
+
+  // `count` (at most 64) bits starting at bit `bit`, the second word is only touched if the bits reach into it
+  inline std::uint64_t Load(const std::uint64_t* words, std::size_t bit, std::size_t count) noexcept {
+    const std::uint64_t* word = words + bit / kWordBits;
+    std::size_t shift = bit % kWordBits;
+    std::uint64_t value = word[0] >> shift;
+    if (shift != 0 && shift + count > kWordBits) {
+      value |= word[1] << (kWordBits - shift);
+    }
+    return value & LowMask(count);
+  }
+
+  // Writes the low `count` bits of value starting at bit `bit`, the other bits are preserved
+  inline void Store(std::uint64_t* words, std::size_t bit, std::size_t count, std::uint64_t value) noexcept {
+    std::uint64_t* word = words + bit / kWordBits;
+    std::size_t shift = bit % kWordBits;
+    std::uint64_t mask = LowMask(count);
+    value &= mask;
+    word[0] = (word[0] & ~(mask << shift)) | (value << shift);
+    if (shift != 0 && shift + count > kWordBits) {
+      std::size_t high = kWordBits - shift;
+      word[1] = (word[1] & ~(mask >> high)) | (value >> high);
+    }
+  }
+
+  // Length of the run starting at bit `bit` that ends at a word boundary or after `remaining` bits
+  constexpr std::size_t RunLength(std::size_t bit, std::size_t remaining) noexcept {
+    return std::min(remaining, kWordBits - bit % kWordBits);
+  }
+
+  // out = op(lhs, rhs) word by word. Runs follow the word boundaries of the output,
+  // so every output word is written once, the inputs are shifted into place.
+  template <class Op>
+  void Combine(const std::uint64_t* lhs, std::size_t lhs_bit, const std::uint64_t* rhs, std::size_t rhs_bit,
+               std::uint64_t* out, std::size_t out_bit, std::size_t size, Op op) {
+    for (std::size_t index = 0; index < size;) {
+      std::size_t count = RunLength(out_bit + index, size - index);
+      std::uint64_t value = op(Load(lhs, lhs_bit + index, count), Load(rhs, rhs_bit + index, count));
+      Store(out, out_bit + index, count, value);
+      index += count;
+    }
+  }
+
+}  // namespace detail::bits
+
+
+// View of bits packed into 64-bit words, bit i of the view is bit (offset + i * stride) of the word array,
+// counting from the least significant bit of the first word.
+// Word is std::uint64_t or const std::uint64_t.
+template
+  < std::size_t extent = std::dynamic_extent
+  , std::ptrdiff_t stride = 1
+  , class Word = std::uint64_t
+  >
+class BitSlice : private detail::ExtentHolder<extent>, private detail::StrideHolder<stride> {
+  static_assert(std::same_as<std::remove_const_t<Word>, std::uint64_t>, "BitSlice works on 64-bit words");
+
+  using ExtentHolder = detail::ExtentHolder<extent>;
+  using StrideHolder = detail::StrideHolder<stride>;
+
+  static constexpr bool is_const = std::is_const_v<Word>;
+
+  // Proxy for one bit of a mutable view
+  class BitReference {
+  public:
+    BitReference(Word* word, std::uint64_t mask) noexcept : word_(word), mask_(mask) {}
+
+    BitReference(const BitReference&) = default;
+
+    operator bool() const noexcept {
+      return (*word_ & mask_) != 0;
+    }
+
+    const BitReference& operator=(bool value) const noexcept {
+      *word_ = value ? (*word_ | mask_) : (*word_ & ~mask_);
+      return *this;
+    }
+
+    const BitReference& operator=(const BitReference& other) const noexcept {
+      return *this = static_cast<bool>(other);
+    }
+
+    void Flip() const noexcept {
+      *word_ ^= mask_;
+    }
+
+  private:
+    Word* word_;
+    std::uint64_t mask_;
+  };
+
+  class IteratorImpl : private detail::StrideHolder<stride> {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = bool;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<is_const, bool, BitReference>;
+
+    IteratorImpl() : detail::StrideHolder<stride>(stride == dynamic_stride ? 0 : stride), words_(nullptr), offset_(0), index_(0) {}
+
+    IteratorImpl(Word* words, std::size_t offset, std::ptrdiff_t index, std::ptrdiff_t step)
+      : detail::StrideHolder<stride>(step), words_(words), offset_(offset), index_(index) {
+
+    }
+
+    IteratorImpl& operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+
+    IteratorImpl operator++(int) noexcept {
+      IteratorImpl copy = *this;
+      ++index_;
+      return copy;
+    }
+
+    IteratorImpl& operator--() noexcept {
+      --index_;
+      return *this;
+    }
+
+    IteratorImpl operator--(int) noexcept {
+      IteratorImpl copy = *this;
+      --index_;
+      return copy;
+    }
+
+    IteratorImpl& operator+=(std::ptrdiff_t n) noexcept {
+      index_ += n;
+      return *this;
+    }
+
+    IteratorImpl& operator-=(std::ptrdiff_t n) noexcept {
+      index_ -= n;
+      return *this;
+    }
+
+    friend IteratorImpl operator+(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator+(std::ptrdiff_t n, IteratorImpl it) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator-(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it -= n;
+    }
+
+    std::ptrdiff_t operator-(const IteratorImpl& other) const noexcept {
+      return index_ - other.index_;
+    }
+
+    bool operator==(const IteratorImpl& other) const noexcept {
+      return index_ == other.index_;
+    }
+
+    auto operator<=>(const IteratorImpl& other) const noexcept {
+      return index_ <=> other.index_;
+    }
+
+    reference operator*() const noexcept {
+      return (*this)[0];
+    }
+
+    reference operator[](std::ptrdiff_t pos) const noexcept {
+      std::size_t bit = offset_ + static_cast<std::size_t>((index_ + pos) * static_cast<std::ptrdiff_t>(this->GetStride()));
+      if constexpr (is_const) {
+        return (words_[bit / detail::bits::kWordBits] >> (bit % detail::bits::kWordBits)) & 1;
+      } else {
+        return BitReference(words_ + bit / detail::bits::kWordBits, std::uint64_t{1} << (bit % detail::bits::kWordBits));
+      }
+    }
+
+  private:
+    Word* words_;
+    std::size_t offset_;
+    std::ptrdiff_t index_;
+  };
+
+public:
+
+  // Typedefs
+
+  using word_type = Word;
+  using value_type = bool;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<is_const, bool, BitReference>;
+  using iterator = IteratorImpl;
+
+  static constexpr std::size_t kWordBits = detail::bits::kWordBits;
+
+  // Constructors
+
+  BitSlice() noexcept
+  requires(extent == 0 || extent == std::dynamic_extent)
+    : ExtentHolder(0), StrideHolder(stride == dynamic_stride ? 1 : stride), words_(nullptr), offset_(0) {
+
+  }
+
+  // `size` bits starting at bit `bit_offset` of words, every `skip`-th bit
+  BitSlice(Word* words, std::size_t size, std::size_t bit_offset = 0, std::ptrdiff_t skip = 1)
+    : ExtentHolder(size), StrideHolder(skip), words_(words + bit_offset / kWordBits), offset_(bit_offset % kWordBits) {
+
+  }
+
+  // All bits of a contiguous container of words
+  template <std::ranges::contiguous_range Container>
+  requires (extent == std::dynamic_extent && std::convertible_to<std::ranges::range_value_t<Container>*, Word*>)
+  explicit BitSlice(Container& container) : BitSlice(std::ranges::data(container), std::ranges::size(container) * kWordBits) {
+
+  }
+
+  BitSlice(const BitSlice&) = default;
+  BitSlice& operator=(const BitSlice&) = default;
+
+  // Casts
+
+  // Forgets the static extent or stride, or the mutability
+  template <std::size_t other_extent, std::ptrdiff_t other_stride, class OtherWord>
+  requires ((extent == std::dynamic_extent || extent == other_extent)
+            && (stride == dynamic_stride || stride == other_stride)
+            && std::convertible_to<OtherWord*, Word*>
+            && !std::same_as<BitSlice, BitSlice<other_extent, other_stride, OtherWord>>)
+  BitSlice(const BitSlice<other_extent, other_stride, OtherWord>& other) noexcept
+    : BitSlice(other.Words(), other.Size(), other.Offset(), other.Stride()) {
+
+  }
+
+  // Element access
+
+  bool Test(size_type pos) const noexcept {
+    std::size_t bit = Position(pos);
+    return (words_[bit / kWordBits] >> (bit % kWordBits)) & 1;
+  }
+
+  reference operator[](size_type pos) const noexcept {
+    if constexpr (is_const) {
+      return Test(pos);
+    } else {
+      std::size_t bit = Position(pos);
+      return BitReference(words_ + bit / kWordBits, std::uint64_t{1} << (bit % kWordBits));
+    }
+  }
+
+  void Set(size_type pos, bool value = true) const noexcept
+  requires (!is_const) {
+    (*this)[pos] = value;
+  }
+
+  void Reset(size_type pos) const noexcept
+  requires (!is_const) {
+    (*this)[pos] = false;
+  }
+
+  // Word holding bit 0 of the view
+  Word* Words() const noexcept {
+    return words_;
+  }
+
+  // Position of bit 0 of the view inside Words()[0]
+  std::size_t Offset() const noexcept {
+    return offset_;
+  }
+
+  // Observers
+
+  constexpr size_type Size() const noexcept {
+    return this->GetExtent();
+  }
+
+  constexpr size_type size() const noexcept {  // for STL compatibility
+    return Size();
+  }
+
+  constexpr std::ptrdiff_t Stride() const noexcept {
+    return static_cast<std::ptrdiff_t>(this->GetStride());
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return this->GetExtent() == 0;
+  }
+
+  // Word-at-a-time kernels, views with stride other than 1 are processed bit by bit
+
+  // Number of set bits
+  std::size_t Count() const noexcept {
+    std::size_t total = 0;
+    if (Stride() == 1) {
+      for (std::size_t index = 0; index < Size();) {
+        std::size_t count = detail::bits::RunLength(offset_ + index, Size() - index);
+        total += static_cast<std::size_t>(std::popcount(detail::bits::Load(words_, offset_ + index, count)));
+        index += count;
+      }
+    } else {
+      for (std::size_t i = 0; i < Size(); ++i) {
+        total += Test(i);
+      }
+    }
+    return total;
+  }
+
+  // Index of the first set bit, Size() if there is none
+  std::size_t FindFirstSet() const noexcept {
+    if (Stride() == 1) {
+      for (std::size_t index = 0; index < Size();) {
+        std::size_t count = detail::bits::RunLength(offset_ + index, Size() - index);
+        std::uint64_t bits = detail::bits::Load(words_, offset_ + index, count);
+        if (bits != 0) {
+          return index + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        index += count;
+      }
+    } else {
+      for (std::size_t i = 0; i < Size(); ++i) {
+        if (Test(i)) return i;
+      }
+    }
+    return Size();
+  }
+
+  void Fill(bool value) const noexcept
+  requires (!is_const) {
+    if (Stride() == 1) {
+      for (std::size_t index = 0; index < Size();) {
+        std::size_t count = detail::bits::RunLength(offset_ + index, Size() - index);
+        detail::bits::Store(words_, offset_ + index, count, value ? ~std::uint64_t{0} : 0);
+        index += count;
+      }
+    } else {
+      for (std::size_t i = 0; i < Size(); ++i) {
+        Set(i, value);
+      }
+    }
+  }
+
+  // Subviews
+
+  auto First(std::size_t count) const noexcept {
+    return Subview<std::dynamic_extent, stride>(0, count, Stride());
+  }
+
+  template <std::size_t count>
+  auto First() const noexcept {
+    return Subview<count, stride>(0, count, Stride());
+  }
+
+  auto Last(std::size_t count) const noexcept {
+    return Subview<std::dynamic_extent, stride>(Size() - count, count, Stride());
+  }
+
+  template <std::size_t count>
+  auto Last() const noexcept {
+    return Subview<count, stride>(Size() - count, count, Stride());
+  }
+
+  auto DropFirst(std::size_t count) const noexcept {
+    return Subview<std::dynamic_extent, stride>(count, Size() - count, Stride());
+  }
+
+  template <std::size_t count>
+  auto DropFirst() const noexcept {
+    constexpr std::size_t new_extent = extent == std::dynamic_extent ? std::dynamic_extent : extent - count;
+    return Subview<new_extent, stride>(count, Size() - count, Stride());
+  }
+
+  auto DropLast(std::size_t count) const noexcept {
+    return Subview<std::dynamic_extent, stride>(0, Size() - count, Stride());
+  }
+
+  template <std::size_t count>
+  auto DropLast() const noexcept {
+    constexpr std::size_t new_extent = extent == std::dynamic_extent ? std::dynamic_extent : extent - count;
+    return Subview<new_extent, stride>(0, Size() - count, Stride());
+  }
+
+  // Skips
+
+  auto Skip(std::ptrdiff_t skip) const noexcept {
+    return Subview<std::dynamic_extent, dynamic_stride>(0, (Size() + skip - 1) / skip, skip * Stride());
+  }
+
+  template <std::ptrdiff_t skip>
+  auto Skip() const noexcept {
+    constexpr std::size_t new_extent = extent == std::dynamic_extent ? std::dynamic_extent : (extent + skip - 1) / skip;
+    constexpr std::ptrdiff_t new_stride = stride == dynamic_stride ? dynamic_stride : stride * skip;
+    return Subview<new_extent, new_stride>(0, (Size() + skip - 1) / skip, skip * Stride());
+  }
+
+  // Iterator methods
+
+  iterator begin() const noexcept {
+    return iterator(words_, offset_, 0, Stride());
+  }
+
+  iterator end() const noexcept {
+    return iterator(words_, offset_, static_cast<std::ptrdiff_t>(Size()), Stride());
+  }
+
+private:
+  std::size_t Position(size_type pos) const noexcept {
+    return offset_ + static_cast<std::size_t>(static_cast<std::ptrdiff_t>(pos) * Stride());
+  }
+
+  template <std::size_t new_extent, std::ptrdiff_t new_stride>
+  BitSlice<new_extent, new_stride, Word> Subview(std::size_t first, std::size_t count, std::ptrdiff_t step) const noexcept {
+    return BitSlice<new_extent, new_stride, Word>(words_, count, Position(first), step);
+  }
+
+  Word* words_;
+  std::size_t offset_;
+};
+
+
+// Deduction guides
+
+template <std::ranges::contiguous_range Container>
+BitSlice(Container&) -> BitSlice<std::dynamic_extent, 1, std::remove_reference_t<std::ranges::range_reference_t<Container>>>;
+
+
+namespace detail::bits {
+
+  template <class Op, class Lhs, class Rhs, class Out>
+  void Apply(const Lhs& lhs, const Rhs& rhs, const Out& out, Op op) {
+    assert(lhs.Size() == out.Size() && rhs.Size() == out.Size());
+    if (lhs.Stride() == 1 && rhs.Stride() == 1 && out.Stride() == 1) {
+      Combine(lhs.Words(), lhs.Offset(), rhs.Words(), rhs.Offset(), out.Words(), out.Offset(), out.Size(), op);
+      return;
+    }
+    for (std::size_t i = 0; i < out.Size(); ++i) {
+      out.Set(i, op(std::uint64_t{lhs.Test(i)}, std::uint64_t{rhs.Test(i)}) & 1);
+    }
+  }
+
+}  // namespace detail::bits
+
+
+// Bitwise operations, out[i] = lhs[i] op rhs[i]. All views have the same size and may start at any bit.
+// out may be one of the inputs.
+
+template <std::size_t e1, std::ptrdiff_t s1, class W1, std::size_t e2, std::ptrdiff_t s2, class W2, std::size_t e3, std::ptrdiff_t s3>
+void And(const BitSlice<e1, s1, W1>& lhs, const BitSlice<e2, s2, W2>& rhs, const BitSlice<e3, s3>& out) {
+  detail::bits::Apply(lhs, rhs, out, [](std::uint64_t a, std::uint64_t b) { return a & b; });
+}
+
+template <std::size_t e1, std::ptrdiff_t s1, class W1, std::size_t e2, std::ptrdiff_t s2, class W2, std::size_t e3, std::ptrdiff_t s3>
+void Or(const BitSlice<e1, s1, W1>& lhs, const BitSlice<e2, s2, W2>& rhs, const BitSlice<e3, s3>& out) {
+  detail::bits::Apply(lhs, rhs, out, [](std::uint64_t a, std::uint64_t b) { return a | b; });
+}
+
+template <std::size_t e1, std::ptrdiff_t s1, class W1, std::size_t e2, std::ptrdiff_t s2, class W2, std::size_t e3, std::ptrdiff_t s3>
+void Xor(const BitSlice<e1, s1, W1>& lhs, const BitSlice<e2, s2, W2>& rhs, const BitSlice<e3, s3>& out) {
+  detail::bits::Apply(lhs, rhs, out, [](std::uint64_t a, std::uint64_t b) { return a ^ b; });
+}
+
+// out[i] = lhs[i] && !rhs[i]
+template <std::size_t e1, std::ptrdiff_t s1, class W1, std::size_t e2, std::ptrdiff_t s2, class W2, std::size_t e3, std::ptrdiff_t s3>
+void AndNot(const BitSlice<e1, s1, W1>& lhs, const BitSlice<e2, s2, W2>& rhs, const BitSlice<e3, s3>& out) {
+  detail::bits::Apply(lhs, rhs, out, [](std::uint64_t a, std::uint64_t b) { return a & ~b; });
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Span.hpp>
+#include <Slice.hpp>
+
+
+// Owning memory mapping of a whole file.
+// Typed views are handed out directly over the mapping, so they are valid as long as the MappedFile lives.
+class MappedFile {
+public:
+  enum class Mode {
+    kReadOnly,
+    kPrivateWritable,  // copy-on-write, changes are never written back to the file
+  };
+
+  enum class Access {
+    kNormal,
+    kSequential,
+    kRandom,
+    kWillNeed,
+  };
+
+  struct Options {
+    Mode mode = Mode::kReadOnly;
+    Access access = Access::kNormal;
+    bool populate = false;    // prefault the whole file on open
+    bool huge_pages = false;  // ask for transparent huge pages
+  };
+
+  // Constructors
+
+  MappedFile() = default;
+
+  explicit MappedFile(const std::string& path) : MappedFile(path, Options{}) {
+
+  }
+
+  MappedFile(const std::string& path, Options options) : mode_(options.mode) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == -1) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+
+    if (size_ != 0) {
+      int protection = mode_ == Mode::kReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+      int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+      if (options.populate) flags |= MAP_POPULATE;
+#endif
+      void* data = ::mmap(nullptr, size_, protection, flags, fd, 0);
+      if (data == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+      }
+      data_ = static_cast<std::byte*>(data);
+    }
+    ::close(fd);
+
+    // Hints are best effort, failures are ignored
+    Advise(options.access);
+#ifdef MADV_HUGEPAGE
+    if (options.huge_pages && data_ != nullptr) {
+      ::madvise(data_, size_, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)), mode_(other.mode_) {
+
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    MappedFile temp = std::move(other);
+    std::swap(data_, temp.data_);
+    std::swap(size_, temp.size_);
+    std::swap(mode_, temp.mode_);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  // Observers
+
+  std::size_t Size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  Mode GetMode() const noexcept {
+    return mode_;
+  }
+
+  const std::byte* Data() const noexcept {
+    return data_;
+  }
+
+  void Advise(Access access) const noexcept {
+    if (data_ == nullptr) return;
+    ::madvise(data_, size_, ToAdvice(access));
+  }
+
+  // Typed views
+  // offset is in bytes, count and stride are in elements.
+  // By default the view extends to the end of the file.
+
+  template <typename T>
+  Span<const T> View(std::size_t offset = 0, std::size_t count = std::dynamic_extent) const {
+    count = Validate<T>(offset, count, 1);
+    return Span<const T>(reinterpret_cast<const T*>(data_ + offset), count);
+  }
+
+  template <typename T>
+  Span<T> MutableView(std::size_t offset = 0, std::size_t count = std::dynamic_extent) {
+    RequireWritable();
+    count = Validate<T>(offset, count, 1);
+    return Span<T>(reinterpret_cast<T*>(data_ + offset), count);
+  }
+
+  template <typename T>
+  Slice<const T, std::dynamic_extent, dynamic_stride> StridedView(
+    std::size_t offset, std::ptrdiff_t stride, std::size_t count = std::dynamic_extent) const {
+    count = Validate<T>(offset, count, stride);
+    return Slice<const T, std::dynamic_extent, dynamic_stride>(reinterpret_cast<const T*>(data_ + offset), count, stride);
+  }
+
+  template <typename T>
+  Slice<T, std::dynamic_extent, dynamic_stride> MutableStridedView(
+    std::size_t offset, std::ptrdiff_t stride, std::size_t count = std::dynamic_extent) {
+    RequireWritable();
+    count = Validate<T>(offset, count, stride);
+    return Slice<T, std::dynamic_extent, dynamic_stride>(reinterpret_cast<T*>(data_ + offset), count, stride);
+  }
+
+private:
+  static int ToAdvice(Access access) noexcept {
+    switch (access) {
+      case Access::kSequential:
+        return MADV_SEQUENTIAL;
+      case Access::kRandom:
+        return MADV_RANDOM;
+      case Access::kWillNeed:
+        return MADV_WILLNEED;
+      default:
+        return MADV_NORMAL;
+    }
+  }
+
+  void RequireWritable() const {
+    if (mode_ != Mode::kPrivateWritable) {
+      throw std::logic_error("MappedFile: mutable view of a read-only mapping");
+    }
+  }
+
+  // Checks that `count` elements of T placed `stride` elements apart fit into the mapping
+  // starting from `offset`, and returns the resolved count
+  template <typename T>
+  std::size_t Validate(std::size_t offset, std::size_t count, std::ptrdiff_t stride) const {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be viewed in place");
+    if (stride <= 0) {
+      throw std::invalid_argument("MappedFile: stride must be positive");
+    }
+    if (offset > size_) {
+      throw std::out_of_range("MappedFile: offset is past the end of the file");
+    }
+    if (reinterpret_cast<std::uintptr_t>(data_ + offset) % alignof(T) != 0) {
+      throw std::invalid_argument("MappedFile: offset is misaligned for the element type");
+    }
+
+    std::size_t step = static_cast<std::size_t>(stride) * sizeof(T);
+    std::size_t available = size_ - offset;
+    std::size_t max_count = available < sizeof(T) ? 0 : (available - sizeof(T)) / step + 1;
+    if (count == std::dynamic_extent) {
+      return max_count;
+    }
+    if (count > max_count) {
+      throw std::out_of_range("MappedFile: view is past the end of the file");
+    }
+    return count;
+  }
+
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  Mode mode_ = Mode::kReadOnly;
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <Slice.hpp>
+
+
+template <std::size_t... extents>
+struct Extents {
+  static constexpr std::size_t rank = sizeof...(extents);
+};
+
+template <std::ptrdiff_t... strides>
+struct Strides {
+  static constexpr std::size_t rank = sizeof...(strides);
+};
+
+
+namespace detail {
+
+  // One dimension, static extent and stride cost no storage
+  template <std::size_t dim, std::size_t extent, std::ptrdiff_t stride>
+  class DimensionHolder : private ExtentHolder<extent>, private StrideHolder<stride> {
+  public:
+    DimensionHolder(std::size_t extent_, std::ptrdiff_t stride_) : ExtentHolder<extent>(extent_), StrideHolder<stride>(stride_) {
+
+    }
+
+    constexpr std::size_t GetExtent() const noexcept {
+      return ExtentHolder<extent>::GetExtent();
+    }
+
+    constexpr std::ptrdiff_t GetStride() const noexcept {
+      return static_cast<std::ptrdiff_t>(StrideHolder<stride>::GetStride());
+    }
+  };
+
+  template <class Indices, class E, class S>
+  class DimensionsHolder;
+
+  template <std::size_t... I, std::size_t... E, std::ptrdiff_t... S>
+  class DimensionsHolder<std::index_sequence<I...>, Extents<E...>, Strides<S...>> : private DimensionHolder<I, E, S>... {
+  public:
+    static constexpr std::size_t rank = sizeof...(I);
+    static constexpr std::array<std::size_t, rank> static_extents{E...};
+    static constexpr std::array<std::ptrdiff_t, rank> static_strides{S...};
+
+    DimensionsHolder(const std::array<std::size_t, rank>& extents, const std::array<std::ptrdiff_t, rank>& strides)
+      : DimensionHolder<I, E, S>(extents[I], strides[I])... {
+
+    }
+
+    template <std::size_t dim>
+    constexpr const auto& Dimension() const noexcept {
+      return static_cast<const DimensionHolder<dim, static_extents[dim], static_strides[dim]>&>(*this);
+    }
+
+    std::array<std::size_t, rank> GetExtents() const noexcept {
+      return {Dimension<I>().GetExtent()...};
+    }
+
+    std::array<std::ptrdiff_t, rank> GetStrides() const noexcept {
+      return {Dimension<I>().GetStride()...};
+    }
+  };
+
+  // Row-major strides, static as far as the inner extents are static
+  template <std::size_t... extents>
+  constexpr auto ContiguousStridesArray() {
+    constexpr std::size_t rank = sizeof...(extents);
+    std::array<std::size_t, rank> sizes{extents...};
+    std::array<std::ptrdiff_t, rank> strides{};
+    std::ptrdiff_t stride = 1;
+    for (std::size_t d = rank; d-- > 0;) {
+      strides[d] = stride;
+      if (stride != dynamic_stride) {
+        stride = sizes[d] == std::dynamic_extent ? dynamic_stride : stride * static_cast<std::ptrdiff_t>(sizes[d]);
+      }
+    }
+    return strides;
+  }
+
+  template <class Indices, std::size_t... extents>
+  struct ContiguousStridesImpl;
+
+  template <std::size_t... I, std::size_t... extents>
+  struct ContiguousStridesImpl<std::index_sequence<I...>, extents...> {
+    using Type = Strides<ContiguousStridesArray<extents...>()[I]...>;
+  };
+
+  inline constexpr std::size_t kTransposeTile = 32;
+
+}  // namespace detail
+
+
+template <std::size_t... extents>
+using ContiguousStrides = typename detail::ContiguousStridesImpl<std::make_index_sequence<sizeof...(extents)>, extents...>::Type;
+
+
+// Rank-N strided view. Every dimension has its own compile-time or dynamic extent and stride (in elements).
+template
+  < class T
+  , class E
+  , class S = void
+  >
+class MdSlice;
+
+template <class T, std::size_t... extents, std::ptrdiff_t... strides>
+requires (sizeof...(extents) == sizeof...(strides) && sizeof...(extents) > 0)
+class MdSlice<T, Extents<extents...>, Strides<strides...>>
+  : private detail::DimensionsHolder<std::make_index_sequence<sizeof...(extents)>, Extents<extents...>, Strides<strides...>> {
+
+  using DimensionsHolder = detail::DimensionsHolder<std::make_index_sequence<sizeof...(extents)>, Extents<extents...>, Strides<strides...>>;
+
+  template <std::size_t dim>
+  static constexpr std::size_t static_extent = DimensionsHolder::static_extents[dim];
+
+  template <std::size_t dim>
+  static constexpr std::ptrdiff_t static_stride = DimensionsHolder::static_strides[dim];
+
+public:
+
+  // Typedefs
+
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T*;
+  using reference = T&;
+  using index_type = std::array<std::size_t, sizeof...(extents)>;
+
+  static constexpr std::size_t rank = sizeof...(extents);
+
+  // Constructors
+
+  MdSlice(T* data, const std::array<std::size_t, rank>& extents_, const std::array<std::ptrdiff_t, rank>& strides_)
+    : DimensionsHolder(extents_, strides_), data_(data) {
+
+  }
+
+  // Everything is known at compile time
+  explicit MdSlice(T* data)
+  requires (((extents != std::dynamic_extent) && ...) && ((strides != dynamic_stride) && ...))
+    : DimensionsHolder({extents...}, {strides...}), data_(data) {
+
+  }
+
+  MdSlice(const MdSlice&) = default;
+  MdSlice& operator=(const MdSlice&) = default;
+
+  // Casts
+
+  operator MdSlice<const T, Extents<extents...>, Strides<strides...>>() const noexcept
+  requires (!std::is_const_v<T>) {
+    return MdSlice<const T, Extents<extents...>, Strides<strides...>>(data_, Sizes(), StepSizes());
+  }
+
+  // Element access
+
+  template <std::convertible_to<std::size_t>... Indices>
+  requires (sizeof...(Indices) == rank)
+  reference operator()(Indices... indices) const noexcept {
+    return (*this)[index_type{static_cast<std::size_t>(indices)...}];
+  }
+
+  reference operator[](const index_type& index) const noexcept {
+    return data_[Offset(index)];
+  }
+
+  pointer Data() const noexcept {
+    return data_;
+  }
+
+  // Observers
+
+  template <std::size_t dim>
+  constexpr std::size_t Extent() const noexcept {
+    return this->template Dimension<dim>().GetExtent();
+  }
+
+  template <std::size_t dim>
+  constexpr std::ptrdiff_t Stride() const noexcept {
+    return this->template Dimension<dim>().GetStride();
+  }
+
+  std::array<std::size_t, rank> Sizes() const noexcept {
+    return this->GetExtents();
+  }
+
+  std::array<std::ptrdiff_t, rank> StepSizes() const noexcept {
+    return this->GetStrides();
+  }
+
+  std::size_t Size() const noexcept {
+    std::size_t size = 1;
+    for (std::size_t extent : Sizes()) {
+      size *= extent;
+    }
+    return size;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return Size() == 0;
+  }
+
+  std::ptrdiff_t Offset(const index_type& index) const noexcept {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return ((static_cast<std::ptrdiff_t>(index[I]) * Stride<I>()) + ... + 0);
+    }(std::make_index_sequence<rank>());
+  }
+
+  // Subviews
+
+  // One-dimensional line along `dim` through `origin`
+  template <std::size_t dim>
+  Slice<T, static_extent<dim>, static_stride<dim>> Line(index_type origin) const noexcept {
+    origin[dim] = 0;
+    return Slice<T, static_extent<dim>, static_stride<dim>>(data_ + Offset(origin), Extent<dim>(), Stride<dim>());
+  }
+
+  auto Row(std::size_t row) const noexcept
+  requires (rank == 2) {
+    return Line<1>({row, 0});
+  }
+
+  auto Col(std::size_t col) const noexcept
+  requires (rank == 2) {
+    return Line<0>({0, col});
+  }
+
+  // Fixed-size block starting at origin
+  template <std::size_t... block_extents>
+  requires (sizeof...(block_extents) == rank)
+  MdSlice<T, Extents<block_extents...>, Strides<strides...>> Block(const index_type& origin) const noexcept {
+    return MdSlice<T, Extents<block_extents...>, Strides<strides...>>(data_ + Offset(origin), {block_extents...}, StepSizes());
+  }
+
+  MdSlice<T, Extents<(static_cast<void>(extents), std::dynamic_extent)...>, Strides<strides...>>
+  Block(const index_type& origin, const std::array<std::size_t, rank>& sizes) const noexcept {
+    return MdSlice<T, Extents<(static_cast<void>(extents), std::dynamic_extent)...>, Strides<strides...>>(data_ + Offset(origin), sizes, StepSizes());
+  }
+
+  // Swaps two dimensions without moving data
+  template <std::size_t first, std::size_t second>
+  auto Permute() const noexcept {
+    constexpr auto swap = [](auto values) {
+      std::swap(values[first], values[second]);
+      return values;
+    };
+    constexpr auto new_extents = swap(DimensionsHolder::static_extents);
+    constexpr auto new_strides = swap(DimensionsHolder::static_strides);
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return MdSlice<T, Extents<new_extents[I]...>, Strides<new_strides[I]...>>(data_, swap(Sizes()), swap(StepSizes()));
+    }(std::make_index_sequence<rank>());
+  }
+
+private:
+  T* data_;
+};
+
+
+namespace detail {
+
+  // dst(j, i) = src(i, j) over one tile
+  template <class Src, class Dst>
+  void TransposeTile(const Src& src, const Dst& dst, std::size_t row_begin, std::size_t row_end, std::size_t col_begin, std::size_t col_end) {
+    const auto* src_data = src.Data();
+    auto* dst_data = dst.Data();
+    std::ptrdiff_t src_row = src.template Stride<0>();
+    std::ptrdiff_t src_col = src.template Stride<1>();
+    std::ptrdiff_t dst_row = dst.template Stride<0>();
+    std::ptrdiff_t dst_col = dst.template Stride<1>();
+    for (std::size_t i = row_begin; i < row_end; ++i) {
+      for (std::size_t j = col_begin; j < col_end; ++j) {
+        dst_data[j * dst_row + i * dst_col] = src_data[i * src_row + j * src_col];
+      }
+    }
+  }
+
+  template <class Src, class Dst>
+  void CopyMatrix(const Src& src, const Dst& dst) {
+    std::size_t rows = src.template Extent<0>();
+    std::size_t cols = src.template Extent<1>();
+    using Element = typename Dst::value_type;
+
+    bool src_rows_contiguous = src.template Stride<1>() == 1;
+    bool dst_rows_contiguous = dst.template Stride<1>() == 1;
+    if (src_rows_contiguous == dst_rows_contiguous || rows <= kTransposeTile || cols <= kTransposeTile) {
+      // Layouts agree, walk rows
+      for (std::size_t i = 0; i < rows; ++i) {
+        if constexpr (std::is_trivially_copyable_v<Element>) {
+          if (src_rows_contiguous && dst_rows_contiguous) {
+            std::memcpy(&dst(i, 0), &src(i, 0), cols * sizeof(Element));
+            continue;
+          }
+        }
+        for (std::size_t j = 0; j < cols; ++j) {
+          dst(i, j) = src(i, j);
+        }
+      }
+      return;
+    }
+
+    // Layouts disagree, copy tile by tile so both sides stay in cache
+    for (std::size_t i = 0; i < rows; i += kTransposeTile) {
+      for (std::size_t j = 0; j < cols; j += kTransposeTile) {
+        std::size_t row_end = std::min(rows, i + kTransposeTile);
+        std::size_t col_end = std::min(cols, j + kTransposeTile);
+        for (std::size_t ii = i; ii < row_end; ++ii) {
+          for (std::size_t jj = j; jj < col_end; ++jj) {
+            dst(ii, jj) = src(ii, jj);
+          }
+        }
+      }
+    }
+  }
+
+  template <std::size_t dim, class Src, class Dst>
+  void CopyRecursive(const Src& src, const Dst& dst, typename Src::index_type& index) {
+    if constexpr (dim + 2 == Src::rank) {
+      std::array<std::size_t, 2> sizes{src.template Extent<dim>(), src.template Extent<dim + 1>()};
+      MdSlice<const typename Src::value_type, Extents<std::dynamic_extent, std::dynamic_extent>, Strides<dynamic_stride, dynamic_stride>>
+        src_matrix(&src[index], sizes, {src.template Stride<dim>(), src.template Stride<dim + 1>()});
+      MdSlice<typename Dst::element_type, Extents<std::dynamic_extent, std::dynamic_extent>, Strides<dynamic_stride, dynamic_stride>>
+        dst_matrix(&dst[index], sizes, {dst.template Stride<dim>(), dst.template Stride<dim + 1>()});
+      CopyMatrix(src_matrix, dst_matrix);
+    } else {
+      for (index[dim] = 0; index[dim] < src.template Extent<dim>(); ++index[dim]) {
+        CopyRecursive<dim + 1>(src, dst, index);
+      }
+      index[dim] = 0;
+    }
+  }
+
+}  // namespace detail
+
+
+// Kernels
+
+// dst(j, i) = src(i, j), the matrices are processed in tiles that fit into L1 on both sides
+template <class Src, class Dst>
+requires (Src::rank == 2 && Dst::rank == 2)
+void Transpose(const Src& src, const Dst& dst) {
+  std::size_t rows = src.template Extent<0>();
+  std::size_t cols = src.template Extent<1>();
+  for (std::size_t i = 0; i < rows; i += detail::kTransposeTile) {
+    for (std::size_t j = 0; j < cols; j += detail::kTransposeTile) {
+      detail::TransposeTile(src, dst, i, std::min(rows, i + detail::kTransposeTile), j, std::min(cols, j + detail::kTransposeTile));
+    }
+  }
+}
+
+// Copies between views of the same extents and any strides
+template <class Src, class Dst>
+requires (Src::rank == Dst::rank)
+void Copy(const Src& src, const Dst& dst) {
+  if constexpr (Src::rank == 1) {
+    for (std::size_t i = 0; i < src.template Extent<0>(); ++i) {
+      dst(i) = src(i);
+    }
+  } else {
+    typename Src::index_type index{};
+    if (src.empty()) return;
+    detail::CopyRecursive<0>(src, dst, index);
+  }
+}
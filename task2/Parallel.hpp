@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Span.hpp>
+#include <Slice.hpp>
+
+
+// Work-stealing thread pool.
+// Every worker owns a deque of tasks: the owner pushes and pops at the back,
+// idle workers steal from the front of the others' deques.
+class ThreadPool {
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+public:
+  explicit ThreadPool(std::size_t threads = DefaultThreadCount()) {
+    threads = std::max<std::size_t>(threads, 1);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+      threads_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Shared pool, the calling thread is expected to help while waiting, so one core is left for it
+  static ThreadPool& Default() {
+    static ThreadPool pool(DefaultThreadCount());
+    return pool;
+  }
+
+  std::size_t Size() const noexcept {
+    return workers_.size();
+  }
+
+  void Submit(std::function<void()> task) {
+    std::size_t index = current_pool_ == this ? current_worker_ : next_worker_.fetch_add(1, std::memory_order_relaxed) % Size();
+    {
+      std::lock_guard lock(workers_[index]->mutex);
+      workers_[index]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+    {
+      // Pairs with the predicate check of sleeping workers, so the wakeup cannot be lost
+      std::lock_guard lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+  }
+
+  // Runs one queued task on the calling thread, returns false if there was none
+  bool RunPendingTask() {
+    std::size_t start = current_pool_ == this ? current_worker_ : next_worker_.load(std::memory_order_relaxed);
+    std::function<void()> task;
+    if (!TryTake(start % Size(), task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+private:
+  static std::size_t DefaultThreadCount() {
+    std::size_t cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+  }
+
+  // Own deque first (LIFO, hot in cache), then steal from the others (FIFO, largest pieces)
+  bool TryTake(std::size_t self, std::function<void()>& task) {
+    if (pending_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    for (std::size_t i = 0; i < Size(); ++i) {
+      Worker& worker = *workers_[(self + i) % Size()];
+      std::lock_guard lock(worker.mutex);
+      if (worker.tasks.empty()) continue;
+      if (i == 0) {
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+      } else {
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+      }
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  void WorkerLoop(std::size_t index) {
+    current_pool_ = this;
+    current_worker_ = index;
+    std::function<void()> task;
+    while (true) {
+      if (TryTake(index, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock lock(sleep_mutex_);
+      sleep_cv_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_acquire) != 0; });
+      if (stop_ && pending_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+
+  static inline thread_local ThreadPool* current_pool_ = nullptr;
+  static inline thread_local std::size_t current_worker_ = 0;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> pending_ = 0;
+  std::atomic<std::size_t> next_worker_ = 0;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  bool stop_ = false;
+};
+
+
+struct ParallelOptions {
+  // Minimal number of elements processed by one task, 0 picks one from the size and the number of threads
+  std::size_t grain = 0;
+  ThreadPool* pool = nullptr;
+};
+
+
+namespace detail {
+
+  inline constexpr std::size_t kCacheLine = 64;
+
+  // Padded slot for per-block partial results, so neighbouring blocks never share a cache line
+  template <typename T>
+  struct alignas(kCacheLine) PaddedValue {
+    T value;
+  };
+
+  template <typename View>
+  auto Subview(const View& view, std::size_t offset, std::size_t count) {
+    return view.Last(view.Size() - offset).First(count);
+  }
+
+  // Splits [0, size) into blocks of `grain` elements. Block boundaries are placed on cache line boundaries
+  // of `anchor`, the view that is written to, so that no two tasks write into the same line.
+  class Blocking {
+  public:
+    template <typename View>
+    Blocking(const View& anchor, std::size_t size, const ParallelOptions& options, std::size_t threads) : size_(size) {
+      using Element = std::remove_cv_t<typename View::element_type>;
+      std::size_t stride = 1;
+      if constexpr (requires { anchor.Stride(); }) {
+        stride = static_cast<std::size_t>(anchor.Stride() > 0 ? anchor.Stride() : 1);
+      }
+      std::size_t line_elements = std::max<std::size_t>(kCacheLine / (sizeof(Element) * stride), 1);
+
+      grain_ = options.grain != 0 ? options.grain : std::max<std::size_t>(size / (threads * 8), 1);
+      grain_ = (grain_ + line_elements - 1) / line_elements * line_elements;
+
+      auto address = reinterpret_cast<std::uintptr_t>(anchor.Data());
+      std::size_t step = sizeof(Element) * stride;
+      if (address % kCacheLine % step == 0 && line_elements > 1) {
+        head_ = (kCacheLine - address % kCacheLine) % kCacheLine / step;
+      }
+    }
+
+    std::size_t Count() const noexcept {
+      if (size_ <= head_ + grain_) return size_ == 0 ? 0 : 1;
+      return 1 + (size_ - head_ - 1) / grain_;
+    }
+
+    std::size_t Begin(std::size_t block) const noexcept {
+      return block == 0 ? 0 : std::min(size_, head_ + block * grain_);
+    }
+
+    std::size_t End(std::size_t block) const noexcept {
+      return std::min(size_, head_ + (block + 1) * grain_);
+    }
+
+  private:
+    std::size_t size_;
+    std::size_t grain_ = 1;
+    std::size_t head_ = 0;
+  };
+
+  // Runs body(block) for every block. Blocks are split in halves recursively, so idle workers
+  // steal large pieces. The calling thread takes part in the work while waiting.
+  template <typename Body>
+  void ParallelBlocks(ThreadPool& pool, std::size_t blocks, const Body& body) {
+    if (blocks == 0) return;
+    if (blocks == 1) {
+      body(0);
+      return;
+    }
+
+    struct Group {
+      std::atomic<std::size_t> remaining;
+      std::mutex mutex;
+      std::exception_ptr error;
+    } group{blocks, {}, {}};
+
+    std::function<void(std::size_t, std::size_t)> run = [&](std::size_t begin, std::size_t end) {
+      while (end - begin > 1) {
+        std::size_t middle = begin + (end - begin) / 2;
+        pool.Submit([&run, middle, end] { run(middle, end); });
+        end = middle;
+      }
+      try {
+        body(begin);
+      } catch (...) {
+        std::lock_guard lock(group.mutex);
+        if (!group.error) group.error = std::current_exception();
+      }
+      group.remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    run(0, blocks);
+    while (group.remaining.load(std::memory_order_acquire) != 0) {
+      if (!pool.RunPendingTask()) {
+        std::this_thread::yield();
+      }
+    }
+    if (group.error) {
+      std::rethrow_exception(group.error);
+    }
+  }
+
+  inline ThreadPool& PoolOf(const ParallelOptions& options) {
+    return options.pool != nullptr ? *options.pool : ThreadPool::Default();
+  }
+
+}  // namespace detail
+
+
+// Algorithms
+// View is a Span or a Slice, subviews are taken with First/Last so strides are preserved.
+
+// f(element) for every element
+template <typename View, typename F>
+void ParallelForEach(const View& view, F f, ParallelOptions options = {}) {
+  ThreadPool& pool = detail::PoolOf(options);
+  detail::Blocking blocking(view, view.Size(), options, pool.Size() + 1);
+  detail::ParallelBlocks(pool, blocking.Count(), [&](std::size_t block) {
+    auto sub = detail::Subview(view, blocking.Begin(block), blocking.End(block) - blocking.Begin(block));
+    for (auto&& element : sub) {
+      f(element);
+    }
+  });
+}
+
+// out[i] = f(in[i]), out must be at least as large as in
+template <typename InView, typename OutView, typename F>
+void ParallelTransform(const InView& in, const OutView& out, F f, ParallelOptions options = {}) {
+  ThreadPool& pool = detail::PoolOf(options);
+  detail::Blocking blocking(out, in.Size(), options, pool.Size() + 1);
+  detail::ParallelBlocks(pool, blocking.Count(), [&](std::size_t block) {
+    std::size_t begin = blocking.Begin(block);
+    std::size_t count = blocking.End(block) - begin;
+    auto sub_in = detail::Subview(in, begin, count);
+    auto sub_out = detail::Subview(out, begin, count);
+    for (std::size_t i = 0; i < count; ++i) {
+      sub_out[i] = f(sub_in[i]);
+    }
+  });
+}
+
+// init op view[0] op view[1] op ..., op must be associative
+template <typename View, typename T, typename Op = std::plus<>>
+T ParallelReduce(const View& view, T init, Op op = {}, ParallelOptions options = {}) {
+  ThreadPool& pool = detail::PoolOf(options);
+  detail::Blocking blocking(view, view.Size(), options, pool.Size() + 1);
+  std::vector<detail::PaddedValue<T>> partial(blocking.Count());
+  detail::ParallelBlocks(pool, blocking.Count(), [&](std::size_t block) {
+    std::size_t begin = blocking.Begin(block);
+    auto sub = detail::Subview(view, begin, blocking.End(block) - begin);
+    T acc = sub[0];
+    for (std::size_t i = 1; i < sub.Size(); ++i) {
+      acc = op(std::move(acc), sub[i]);
+    }
+    partial[block].value = std::move(acc);
+  });
+  for (auto& value : partial) {
+    init = op(std::move(init), std::move(value.value));
+  }
+  return init;
+}
+
+// Inclusive scan: out[i] = init op in[0] op ... op in[i], op must be associative.
+// Two passes: per-block totals, then per-block scans seeded with the prefix of the totals.
+template <typename InView, typename OutView, typename T, typename Op = std::plus<>>
+void ParallelScan(const InView& in, const OutView& out, T init, Op op = {}, ParallelOptions options = {}) {
+  ThreadPool& pool = detail::PoolOf(options);
+  detail::Blocking blocking(out, in.Size(), options, pool.Size() + 1);
+  std::vector<detail::PaddedValue<T>> prefix(blocking.Count());
+  detail::ParallelBlocks(pool, blocking.Count(), [&](std::size_t block) {
+    std::size_t begin = blocking.Begin(block);
+    auto sub = detail::Subview(in, begin, blocking.End(block) - begin);
+    T acc = sub[0];
+    for (std::size_t i = 1; i < sub.Size(); ++i) {
+      acc = op(std::move(acc), sub[i]);
+    }
+    prefix[block].value = std::move(acc);
+  });
+  for (auto& value : prefix) {
+    T total = std::move(value.value);
+    value.value = init;
+    init = op(std::move(init), std::move(total));
+  }
+  detail::ParallelBlocks(pool, blocking.Count(), [&](std::size_t block) {
+    std::size_t begin = blocking.Begin(block);
+    std::size_t count = blocking.End(block) - begin;
+    auto sub_in = detail::Subview(in, begin, count);
+    auto sub_out = detail::Subview(out, begin, count);
+    T acc = prefix[block].value;
+    for (std::size_t i = 0; i < count; ++i) {
+      acc = op(std::move(acc), sub_in[i]);
+      sub_out[i] = acc;
+    }
+  });
+}
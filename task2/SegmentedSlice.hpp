@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Span.hpp>
+#include <SpanKernels.hpp>
+
+// A sequence of contiguous segments presented as one random-access view.
+//
+//   SegmentTable<const char> table(blocks);       // once per buffer list
+//   auto body = table.View().DropFirst(header);   // no copy
+//   body.ForEachSegment([](Span<const char> s) { ... });
+//
+// The table keeps the prefix offsets of the segments, element lookup is a division when all segments
+// but the last have the same size and a binary search otherwise. Bulk algorithms run their inner loop
+// on one Span per segment, so the hot loop stays contiguous.
+
+
+template <class T>
+class SegmentedSlice;
+
+
+// Segments and their prefix offsets. Segments are referenced, not owned, and must outlive the table.
+template <class T>
+class SegmentTable {
+public:
+  SegmentTable() = default;
+
+  // Every element of segments must be convertible to Span<T>
+  template <std::ranges::input_range Segments>
+  requires std::convertible_to<std::ranges::range_reference_t<Segments>, Span<T>>
+  explicit SegmentTable(Segments&& segments) {
+    for (auto&& segment : segments) {
+      Append(segment);
+    }
+  }
+
+  void Append(Span<T> segment) {
+    if (data_.empty()) {
+      block_ = segment.Size();
+    } else if (Segment(data_.size() - 1).Size() != block_) {
+      // only the last segment may be shorter
+      block_ = 0;
+    }
+    data_.push_back(segment.Data());
+    offsets_.push_back(offsets_.back() + segment.Size());
+  }
+
+  std::size_t Size() const noexcept {
+    return offsets_.back();
+  }
+
+  std::size_t SegmentCount() const noexcept {
+    return data_.size();
+  }
+
+  Span<T> Segment(std::size_t segment) const noexcept {
+    return Span<T>(data_[segment], offsets_[segment + 1] - offsets_[segment]);
+  }
+
+  // Index of the first element of a segment
+  std::size_t SegmentBegin(std::size_t segment) const noexcept {
+    return offsets_[segment];
+  }
+
+  // Segment holding element `index` and the position inside it. Size() maps to {SegmentCount(), 0}.
+  std::pair<std::size_t, std::size_t> Locate(std::size_t index) const noexcept {
+    if (index >= Size()) {
+      return {SegmentCount(), 0};
+    }
+    if (block_ != 0) {
+      // the last segment may be longer than the others
+      std::size_t segment = std::min(index / block_, SegmentCount() - 1);
+      return {segment, index - offsets_[segment]};
+    }
+    std::size_t segment = static_cast<std::size_t>(std::upper_bound(offsets_.begin(), offsets_.end(), index) - offsets_.begin()) - 1;
+    return {segment, index - offsets_[segment]};
+  }
+
+  T& operator[](std::size_t index) const noexcept {
+    auto [segment, offset] = Locate(index);
+    return data_[segment][offset];
+  }
+
+  SegmentedSlice<T> View() const noexcept {
+    return SegmentedSlice<T>(*this, 0, Size());
+  }
+
+private:
+  std::vector<T*> data_;
+  std::vector<std::size_t> offsets_{0};
+  // Size of every segment but the last one, 0 if they differ
+  std::size_t block_ = 0;
+};
+
+
+// Elements [begin, begin + size) of a segment table, subviews only move the bounds
+template <class T>
+class SegmentedSlice {
+  class IteratorImpl {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    IteratorImpl() = default;
+
+    IteratorImpl(const SegmentTable<T>* table, std::size_t index) : table_(table), index_(index) {
+      Seek();
+    }
+
+    // Stepping stays inside the current segment until its end
+    IteratorImpl& operator++() noexcept {
+      ++index_;
+      if (++current_ == limit_) Seek();
+      return *this;
+    }
+
+    IteratorImpl operator++(int) noexcept {
+      IteratorImpl copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    IteratorImpl& operator--() noexcept {
+      --index_;
+      Seek();
+      return *this;
+    }
+
+    IteratorImpl operator--(int) noexcept {
+      IteratorImpl copy = *this;
+      --*this;
+      return copy;
+    }
+
+    IteratorImpl& operator+=(std::ptrdiff_t n) noexcept {
+      index_ += n;
+      Seek();
+      return *this;
+    }
+
+    IteratorImpl& operator-=(std::ptrdiff_t n) noexcept {
+      return *this += -n;
+    }
+
+    friend IteratorImpl operator+(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator+(std::ptrdiff_t n, IteratorImpl it) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator-(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it -= n;
+    }
+
+    std::ptrdiff_t operator-(const IteratorImpl& other) const noexcept {
+      return static_cast<std::ptrdiff_t>(index_) - static_cast<std::ptrdiff_t>(other.index_);
+    }
+
+    bool operator==(const IteratorImpl& other) const noexcept {
+      return index_ == other.index_;
+    }
+
+    auto operator<=>(const IteratorImpl& other) const noexcept {
+      return index_ <=> other.index_;
+    }
+
+    reference operator*() const noexcept {
+      return *current_;
+    }
+
+    reference operator[](std::ptrdiff_t pos) const noexcept {
+      return (*table_)[index_ + pos];
+    }
+
+    pointer operator->() const noexcept {
+      return current_;
+    }
+
+  private:
+    void Seek() noexcept {
+      auto [segment, offset] = table_->Locate(index_);
+      if (segment == table_->SegmentCount()) {
+        current_ = limit_ = nullptr;
+        return;
+      }
+      Span<T> span = table_->Segment(segment);
+      current_ = span.Data() + offset;
+      limit_ = span.Data() + span.Size();
+    }
+
+    const SegmentTable<T>* table_ = nullptr;
+    std::size_t index_ = 0;
+    T* current_ = nullptr;
+    T* limit_ = nullptr;
+  };
+
+public:
+
+  // Typedefs
+
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using iterator = IteratorImpl;
+
+  // Constructors
+
+  SegmentedSlice(const SegmentTable<T>& table, std::size_t begin, std::size_t size) noexcept : table_(&table), begin_(begin), size_(size) {
+    assert(begin + size <= table.Size());
+  }
+
+  SegmentedSlice(const SegmentedSlice&) = default;
+  SegmentedSlice& operator=(const SegmentedSlice&) = default;
+
+  // Element access
+
+  reference operator[](size_type pos) const noexcept {
+    return (*table_)[begin_ + pos];
+  }
+
+  reference Front() const noexcept {
+    return (*this)[0];
+  }
+
+  reference Back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  // Observers
+
+  size_type Size() const noexcept {
+    return size_;
+  }
+
+  size_type size() const noexcept {  // for STL compatibility
+    return Size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Number of segments the view touches
+  std::size_t SegmentCount() const noexcept {
+    if (empty()) return 0;
+    return table_->Locate(begin_ + size_ - 1).first - table_->Locate(begin_).first + 1;
+  }
+
+  // Subviews
+
+  SegmentedSlice First(std::size_t count) const noexcept {
+    return SegmentedSlice(*table_, begin_, count);
+  }
+
+  SegmentedSlice Last(std::size_t count) const noexcept {
+    return SegmentedSlice(*table_, begin_ + size_ - count, count);
+  }
+
+  SegmentedSlice DropFirst(std::size_t count) const noexcept {
+    return SegmentedSlice(*table_, begin_ + count, size_ - count);
+  }
+
+  SegmentedSlice DropLast(std::size_t count) const noexcept {
+    return SegmentedSlice(*table_, begin_, size_ - count);
+  }
+
+  // Segment-wise traversal
+
+  // f(Span<T> piece) for the part of every segment that lies inside the view, in order.
+  // If f returns bool, returning false stops the traversal.
+  template <class F>
+  void ForEachSegment(F&& f) const {
+    if (empty()) return;
+    auto [segment, offset] = table_->Locate(begin_);
+    for (std::size_t remaining = size_; remaining != 0; ++segment, offset = 0) {
+      Span<T> piece = table_->Segment(segment);
+      std::size_t count = std::min(remaining, piece.Size() - offset);
+      if (count == 0) continue;
+      remaining -= count;
+      if constexpr (std::is_same_v<std::invoke_result_t<F&, Span<T>>, bool>) {
+        if (!f(Span<T>(piece.Data() + offset, count))) return;
+      } else {
+        f(Span<T>(piece.Data() + offset, count));
+      }
+    }
+  }
+
+  // f(element) for every element, the inner loop runs over raw segment pointers
+  template <class F>
+  void ForEach(F f) const {
+    ForEachSegment([&f](Span<T> piece) {
+      T* data = piece.Data();
+      for (std::size_t i = 0, size = piece.Size(); i < size; ++i) {
+        f(data[i]);
+      }
+    });
+  }
+
+  // Iterator methods
+
+  iterator begin() const noexcept {
+    return iterator(table_, begin_);
+  }
+
+  iterator end() const noexcept {
+    return iterator(table_, begin_ + size_);
+  }
+
+private:
+  const SegmentTable<T>* table_;
+  std::size_t begin_;
+  std::size_t size_;
+};
+
+
+// Algorithms
+
+// Copies the view into a contiguous buffer of at least the same size
+template <class T, class U, std::size_t extent>
+requires std::same_as<std::remove_cv_t<T>, U>
+void CopyTo(const SegmentedSlice<T>& source, const Span<U, extent>& destination) {
+  assert(destination.Size() >= source.Size());
+  U* out = destination.Data();
+  source.ForEachSegment([&out](Span<T> piece) {
+    if constexpr (std::is_trivially_copyable_v<U>) {
+      std::memcpy(out, piece.Data(), piece.Size() * sizeof(U));
+    } else {
+      std::copy(piece.begin(), piece.end(), out);
+    }
+    out += piece.Size();
+  });
+}
+
+// Fills the view from a contiguous buffer of at least the same size
+template <class T, class U, std::size_t extent>
+requires (!std::is_const_v<T> && std::same_as<T, std::remove_cv_t<U>>)
+void CopyFrom(const SegmentedSlice<T>& destination, const Span<U, extent>& source) {
+  assert(source.Size() >= destination.Size());
+  const T* in = source.Data();
+  destination.ForEachSegment([&in](Span<T> piece) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memcpy(piece.Data(), in, piece.Size() * sizeof(T));
+    } else {
+      std::copy(in, in + piece.Size(), piece.begin());
+    }
+    in += piece.Size();
+  });
+}
+
+// Index of the first element equal to value, Size() if there is none.
+// Arithmetic elements are searched with the vector kernels of SpanKernels.hpp segment by segment.
+template <class T>
+std::size_t Find(const SegmentedSlice<T>& view, const std::remove_cv_t<T>& value) {
+  std::size_t result = view.Size();
+  std::size_t position = 0;
+  view.ForEachSegment([&](Span<T> piece) {
+    std::size_t found;
+    if constexpr (detail::simd::KernelSpan<Span<T>>) {
+      found = Find(piece, value);
+    } else {
+      found = static_cast<std::size_t>(std::find(piece.begin(), piece.end(), value) - piece.begin());
+    }
+    if (found != piece.Size()) {
+      result = position + found;
+      return false;
+    }
+    position += piece.Size();
+    return true;
+  });
+  return result;
+}
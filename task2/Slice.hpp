@@ -1,8 +1,14 @@
+#pragma once
+
 #include <span>
 #include <concepts>
 #include <cstdlib>
 #include <array>
+#include <cassert>
+#include <cstring>
 #include <iterator>
+#include <ranges>
+#include <type_traits>
 
 inline constexpr std::ptrdiff_t dynamic_stride = -1;
 
@@ -58,6 +64,9 @@ namespace detail {
 
   };
 
+  template <class T, std::size_t chunk_extent, std::ptrdiff_t stride>
+  class SliceChunks;
+
 }  // namespace detail
 
 
@@ -71,75 +80,101 @@ class Slice : private detail::ExtentHolder<extent>, private detail::StrideHolder
   using ExtentHolder = detail::ExtentHolder<extent>;
   using StrideHolder = detail::StrideHolder<stride>;
 
+  // Iterators keep the base pointer and an element index, so the distance between two iterators
+  // is a subtraction and the address is recomputed as base + index * stride. Loops over indices
+  // are strength-reduced by the compiler, unlike the division a pointer-based distance needs.
   template <bool is_const>
-  class IteratorImpl {
+  class IteratorImpl : private detail::StrideHolder<stride> {
   public:
     using iterator_category = std::random_access_iterator_tag;
-    using value_type = std::conditional_t<is_const, const T, T>;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
     using difference_type = std::ptrdiff_t;
-    using pointer = value_type*;
-    using reference = value_type&;
+    using pointer = std::conditional_t<is_const, const T*, T*>;
+    using reference = std::conditional_t<is_const, const T&, T&>;
 
   private:
     pointer data_;
-    std::ptrdiff_t stride_;
+    std::ptrdiff_t index_;
   
   public:
 
-    IteratorImpl() : data_(nullptr), stride_(0) {}
+    IteratorImpl() : detail::StrideHolder<stride>(stride == dynamic_stride ? 0 : stride), data_(nullptr), index_(0) {}
   
-    IteratorImpl(pointer data, std::ptrdiff_t stride_) : data_(data), stride_(stride_) {}
+    IteratorImpl(pointer data, std::ptrdiff_t index, std::ptrdiff_t step) : detail::StrideHolder<stride>(step), data_(data), index_(index) {}
 
     IteratorImpl& operator++() noexcept {
-      data_ += stride_;
+      ++index_;
       return *this;
     }
 
     IteratorImpl operator++(int) noexcept {
       IteratorImpl copy = *this;
-      data_ += stride_;
+      ++index_;
       return copy;
     }
 
     IteratorImpl& operator--() noexcept {
-      data_ -= stride_;
+      --index_;
       return *this;
     }
 
     IteratorImpl operator--(int) noexcept {
       IteratorImpl copy = *this;
-      data_ -= stride_;
+      --index_;
       return copy;
     }
 
     IteratorImpl& operator+=(std::ptrdiff_t n) noexcept {
-      data_ += n * stride_;
+      index_ += n;
       return *this;
     }
 
     IteratorImpl& operator-=(std::ptrdiff_t n) noexcept {
-      data_ -= n * stride_;
+      index_ -= n;
       return *this;
     }
 
+    friend IteratorImpl operator+(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator+(std::ptrdiff_t n, IteratorImpl it) noexcept {
+      return it += n;
+    }
+
+    friend IteratorImpl operator-(IteratorImpl it, std::ptrdiff_t n) noexcept {
+      return it -= n;
+    }
+
     std::ptrdiff_t operator-(const IteratorImpl& other) const noexcept {
-      return (data_ - other.data_) / stride_;
+      return index_ - other.index_;
     }
 
-    auto operator<=>(const IteratorImpl& other) const noexcept = default;
+    bool operator==(const IteratorImpl& other) const noexcept {
+      return index_ == other.index_;
+    }
+
+    auto operator<=>(const IteratorImpl& other) const noexcept {
+      return index_ <=> other.index_;
+    }
     
     reference operator*() const noexcept {
-      return *data_;
+      return data_[index_ * Step()];
     }
 
-    reference operator[](std::size_t pos) const noexcept {
-      return data_[pos * stride_];
+    reference operator[](std::ptrdiff_t pos) const noexcept {
+      return data_[(index_ + pos) * Step()];
     }
 
     pointer operator->() const noexcept {
-      return data_;
+      return data_ + index_ * Step();
     }
 
+  private:
+    std::ptrdiff_t Step() const noexcept {
+      return static_cast<std::ptrdiff_t>(this->GetStride());
+    }
   };
 
 public:
@@ -159,21 +194,11 @@ public:
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-  // Friends
-
-  template <bool is_const>
-  friend IteratorImpl<is_const> operator+(const IteratorImpl<is_const>&, std::ptrdiff_t);
-
-  template <bool is_const>
-  friend typename Slice<T, extent, stride>::template IteratorImpl<is_const> operator+(std::ptrdiff_t n, const typename Slice<T, extent, stride>::template IteratorImpl<is_const>& it);
-
-  template <bool is_const>
-  friend IteratorImpl<is_const> operator-(const IteratorImpl<is_const>&, std::ptrdiff_t);
-
   // Constructors
 
   Slice() noexcept 
-  requires(extent == 0 || extent == std::dynamic_extent) {
+  requires(extent == 0 || extent == std::dynamic_extent)
+  : ExtentHolder(0), StrideHolder(stride == dynamic_stride ? 1 : stride), data_(nullptr) {
 
   }
 
@@ -210,7 +235,7 @@ public:
 
   operator Slice<T, std::dynamic_extent, stride>() const noexcept 
   requires (extent != std::dynamic_extent) {
-    return Slice(data_, this->GetExtent(), this->GetStride());
+    return Slice<T, std::dynamic_extent, stride>(data_, this->GetExtent(), this->GetStride());
   }
 
   operator Slice<T, extent, dynamic_stride>() const noexcept 
@@ -220,11 +245,11 @@ public:
 
   operator Slice<T, std::dynamic_extent, dynamic_stride>() const noexcept 
   requires (extent != std::dynamic_extent && stride != dynamic_stride) {
-    return Slice(data_, this->GetExtent(), this->GetStride());
+    return Slice<T, std::dynamic_extent, dynamic_stride>(data_, this->GetExtent(), this->GetStride());
   }
 
   operator Slice<const T, extent, stride>() const noexcept {
-    return Slice(data_, this->GetExtent(), this->GetStride());
+    return Slice<const T, extent, stride>(data_, this->GetExtent(), this->GetStride());
   }
 
   operator Slice<const T, std::dynamic_extent, stride>() const noexcept
@@ -334,6 +359,28 @@ public:
     return Slice<T, extent - count, stride>(data_, extent - count, this->GetStride());
   }
 
+  // Blocking
+
+  // Consecutive blocks of count elements, the incomplete last block is available as Remainder()
+  template <std::size_t count>
+  auto Chunks() const noexcept {
+    static_assert(count != 0 && count != std::dynamic_extent);
+    return detail::SliceChunks<T, count, stride>(AsDynamic(), this->GetExtent() / count, count, count, this->GetExtent() % count);
+  }
+
+  auto Chunks(std::size_t count) const noexcept {
+    assert(count != 0);
+    return detail::SliceChunks<T, std::dynamic_extent, stride>(AsDynamic(), this->GetExtent() / count, count, count, this->GetExtent() % count);
+  }
+
+  // All subviews of count consecutive elements
+  template <std::size_t count>
+  auto Windows() const noexcept {
+    static_assert(count != 0 && count != std::dynamic_extent);
+    std::size_t windows = this->GetExtent() < count ? 0 : this->GetExtent() - count + 1;
+    return detail::SliceChunks<T, count, stride>(AsDynamic(), windows, count, 1, 0);
+  }
+
   // Skips
 
   auto Skip(std::ptrdiff_t skip) const noexcept {
@@ -364,22 +411,55 @@ public:
     return Slice<T, (extent + skip - 1) / skip, skip * stride>(data_, (extent + skip - 1) / skip, skip * stride);
   }
 
+  // Iteration
+
+  // Calls f with an equivalent slice whose stride is a compile-time constant when the runtime stride is 1, 2 or 4,
+  // so loops in f are compiled for that stride. Other strides call f(*this).
+  template <class F>
+  auto VisitStride(F&& f) const -> decltype(f(*this)) {
+    if constexpr (stride == dynamic_stride) {
+      switch (this->GetStride()) {
+        case 1:
+          return f(Slice<T, extent, 1>(data_, this->GetExtent(), 1));
+        case 2:
+          return f(Slice<T, extent, 2>(data_, this->GetExtent(), 2));
+        case 4:
+          return f(Slice<T, extent, 4>(data_, this->GetExtent(), 4));
+        default:
+          break;
+      }
+    }
+    return f(*this);
+  }
+
+  // f(element) for every element, as a counted loop with the stride kept out of the loop body
+  template <class F>
+  void ForEach(F f) const {
+    VisitStride([&f](const auto& slice) {
+      T* data = slice.Data();
+      std::ptrdiff_t step = slice.Stride();
+      for (std::size_t i = 0, size = slice.Size(); i < size; ++i) {
+        f(data[static_cast<std::ptrdiff_t>(i) * step]);
+      }
+    });
+  }
+
   // Iterator methods
 
   iterator begin() const noexcept {
-    return iterator(data_, this->GetStride());
+    return iterator(data_, 0, this->GetStride());
   }
 
   const_iterator cbegin() const noexcept {
-    return const_iterator(data_, this->GetStride());
+    return const_iterator(data_, 0, this->GetStride());
   }
 
   iterator end() const noexcept {
-    return iterator(data_ + this->GetExtent() * this->GetStride(), this->GetStride());
+    return iterator(data_, static_cast<std::ptrdiff_t>(this->GetExtent()), this->GetStride());
   }
 
   const_iterator cend() const noexcept {
-    return const_iterator(data_ + this->GetExtent() * this->GetStride(), this->GetStride());
+    return const_iterator(data_, static_cast<std::ptrdiff_t>(this->GetExtent()), this->GetStride());
   }
 
   reverse_iterator rbegin() const noexcept {
@@ -399,16 +479,164 @@ public:
   }
 
 private:
+  // The same elements with the extent erased, spelled out so that no conversion operator is involved
+  Slice<T, std::dynamic_extent, stride> AsDynamic() const noexcept {
+    return Slice<T, std::dynamic_extent, stride>(data_, this->GetExtent(), this->GetStride());
+  }
+
   T* data_;
   // std::size_t extent_; ?
   // std::ptrdiff_t stride_; ?
 };
 
+namespace detail {
+
+  // Range of `count` subviews of `chunk` elements each, starting `step` elements apart
+  template <class T, std::size_t chunk_extent, std::ptrdiff_t stride>
+  class SliceChunks {
+    using Base = Slice<T, std::dynamic_extent, stride>;
+
+  public:
+    using value_type = Slice<T, chunk_extent, stride>;
+
+    class iterator {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Slice<T, chunk_extent, stride>;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+
+      iterator() = default;
+
+      iterator(const SliceChunks& chunks, std::size_t index) : chunks_(chunks), index_(index) {}
+
+      value_type operator*() const {
+        return chunks_[index_];
+      }
+
+      value_type operator[](difference_type n) const {
+        return chunks_[index_ + n];
+      }
+
+      iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+      }
+
+      iterator operator++(int) noexcept {
+        iterator copy = *this;
+        ++index_;
+        return copy;
+      }
+
+      iterator& operator--() noexcept {
+        --index_;
+        return *this;
+      }
+
+      iterator operator--(int) noexcept {
+        iterator copy = *this;
+        --index_;
+        return copy;
+      }
+
+      iterator& operator+=(difference_type n) noexcept {
+        index_ += n;
+        return *this;
+      }
+
+      iterator& operator-=(difference_type n) noexcept {
+        index_ -= n;
+        return *this;
+      }
+
+      friend iterator operator+(iterator it, difference_type n) noexcept {
+        return it += n;
+      }
+
+      friend iterator operator+(difference_type n, iterator it) noexcept {
+        return it += n;
+      }
+
+      friend iterator operator-(iterator it, difference_type n) noexcept {
+        return it -= n;
+      }
+
+      difference_type operator-(const iterator& other) const noexcept {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+      }
+
+      bool operator==(const iterator& other) const noexcept {
+        return index_ == other.index_;
+      }
+
+      auto operator<=>(const iterator& other) const noexcept {
+        return index_ <=> other.index_;
+      }
+
+    private:
+      SliceChunks chunks_;
+      std::size_t index_ = 0;
+    };
+
+    SliceChunks() = default;
+
+    SliceChunks(Base base, std::size_t count, std::size_t chunk, std::size_t step, std::size_t remainder) noexcept
+      : base_(base), count_(count), chunk_(chunk), step_(step), remainder_(remainder) {
+
+    }
+
+    std::size_t Size() const noexcept {
+      return count_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return count_ == 0;
+    }
+
+    value_type operator[](std::size_t index) const noexcept {
+      if constexpr (chunk_extent == std::dynamic_extent) {
+        return base_.DropFirst(index * step_).First(chunk_);
+      } else {
+        return base_.DropFirst(index * step_).template First<chunk_extent>();
+      }
+    }
+
+    // Elements not covered by any chunk
+    Base Remainder() const noexcept {
+      return base_.DropFirst(count_ * step_).First(remainder_);
+    }
+
+    iterator begin() const noexcept {
+      return iterator(*this, 0);
+    }
+
+    iterator end() const noexcept {
+      return iterator(*this, count_);
+    }
+
+  private:
+    Base base_;
+    std::size_t count_ = 0;
+    std::size_t chunk_ = 0;
+    std::size_t step_ = 1;
+    std::size_t remainder_ = 0;
+  };
+
+}  // namespace detail
+
 // Outside of class operators
 
 template <typename T1, typename T2, std::size_t ext1, std::size_t ext2, std::ptrdiff_t str1, std::ptrdiff_t str2>
 bool operator==(const Slice<T1, ext1, str1>& s1, const Slice<T2, ext2, str2>& s2) {
   if (s1.Size() != s2.Size()) return false;
+  // Contiguous scalars without padding bits are equal exactly when their bytes are
+  using Element = std::remove_cv_t<T1>;
+  if constexpr (std::is_same_v<Element, std::remove_cv_t<T2>> && std::is_scalar_v<Element> && std::has_unique_object_representations_v<Element>) {
+    if (s1.Stride() == 1 && s2.Stride() == 1) {
+      return s1.Size() == 0 || std::memcmp(s1.Data(), s2.Data(), s1.Size() * sizeof(Element)) == 0;
+    }
+  }
   auto it1 = s1.begin();
   auto it2 = s2.begin();
   for (; it1 != s1.end(); ++it1, ++it2) {
@@ -417,24 +645,13 @@ bool operator==(const Slice<T1, ext1, str1>& s1, const Slice<T2, ext2, str2>& s2
   return true;
 }
 
-template <class T, std::size_t extent = std::dynamic_extent, std::ptrdiff_t stride = 1, bool is_const>
-typename Slice<T, extent, stride>::template IteratorImpl<is_const> operator+(const typename Slice<T, extent, stride>::template IteratorImpl<is_const>& it, std::ptrdiff_t n) {
-  auto copy = it;
-  copy += n;
-  return copy;
-}
+// Slices are cheap to copy and never own their elements
 
-template <class T, std::size_t extent = std::dynamic_extent, std::ptrdiff_t stride = 1, bool is_const>
-typename Slice<T, extent, stride>::template IteratorImpl<is_const> operator+(std::ptrdiff_t n, const typename Slice<T, extent, stride>::template IteratorImpl<is_const>& it) {
-  return it + n;
-}
+template <class T, std::size_t extent, std::ptrdiff_t stride>
+inline constexpr bool std::ranges::enable_borrowed_range<Slice<T, extent, stride>> = true;
 
-template <class T, std::size_t extent = std::dynamic_extent, std::ptrdiff_t stride = 1, bool is_const>
-typename Slice<T, extent, stride>::template IteratorImpl<is_const> operator-(const typename Slice<T, extent, stride>::template IteratorImpl<is_const>& it, std::ptrdiff_t n) {
-  auto copy = it;
-  copy -= n;
-  return copy;
-}
+template <class T, std::size_t extent, std::ptrdiff_t stride>
+inline constexpr bool std::ranges::enable_view<Slice<T, extent, stride>> = true;
 
 // Deduction guides
 
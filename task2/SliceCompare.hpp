@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include <Span.hpp>
+#include <Slice.hpp>
+#include <SliceCopy.hpp>
+
+// Equality, lexicographic comparison, mismatch search and hashing over Slices and Spans.
+//
+//   std::unordered_map<Slice<const int, std::dynamic_extent, dynamic_stride>, Entry, ViewHash, ViewEqual> cache;
+//
+// Scalars without padding bits are compared as raw bytes: contiguous views go straight to memcmp,
+// strided views are gathered block by block into a buffer on the stack (shuffles for strides up to 4,
+// see SliceCopy.hpp) and compared the same way. Other element types use their own operators.
+// Hash depends only on the elements, not on the stride, so it is consistent with Equals.
+
+
+namespace detail::compare {
+
+  inline constexpr std::size_t kBlockBytes = 256;
+
+  template <class V>
+  struct ViewTraits : std::false_type {};
+
+  template <class T, std::size_t extent, std::ptrdiff_t stride>
+  struct ViewTraits<Slice<T, extent, stride>> : std::true_type {
+    using Element = std::remove_cv_t<T>;
+  };
+
+  template <class T, std::size_t extent>
+  struct ViewTraits<Span<T, extent>> : std::true_type {
+    using Element = std::remove_cv_t<T>;
+  };
+
+  template <class V>
+  concept View = ViewTraits<V>::value;
+
+  template <class V>
+  using ElementOf = typename ViewTraits<V>::Element;
+
+  // Equal values have equal bytes and vice versa
+  template <class T>
+  concept Bytewise = std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
+
+  template <class T>
+  using Underlying = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+
+  // Byte order is value order
+  template <class T>
+  concept ByteOrdered = Bytewise<T> && sizeof(T) == 1 && std::is_unsigned_v<Underlying<T>>;
+
+  template <class A, class B>
+  concept BytewiseComparable = std::same_as<ElementOf<A>, ElementOf<B>> && Bytewise<ElementOf<A>>;
+
+  template <View V>
+  std::ptrdiff_t StrideOf(const V& view) noexcept {
+    if constexpr (requires { view.Stride(); }) {
+      return view.Stride();
+    } else {
+      return 1;
+    }
+  }
+
+  // Hands out [offset, offset + count) of the view as a contiguous range.
+  // Contiguous views are returned in place, strided ones are gathered into `buffer`.
+  template <View V>
+  const ElementOf<V>* Contiguous(const V& view, std::size_t offset, std::size_t count, ElementOf<V>* buffer) {
+    if (StrideOf(view) == 1) {
+      return view.Data() + offset;
+    }
+    if constexpr (requires { view.Stride(); }) {
+      CopyTo(view.DropFirst(offset).First(count), Span<ElementOf<V>>(buffer, count));
+    }
+    return buffer;
+  }
+
+  template <class T>
+  inline constexpr std::size_t kBlockElements = std::max<std::size_t>(kBlockBytes / sizeof(T), 1);
+
+  // Index of the first pair of elements with different bytes, or the size of the shorter view
+  template <View A, View B>
+  std::size_t MismatchBytes(const A& lhs, const B& rhs) {
+    using T = ElementOf<A>;
+    constexpr std::size_t kBlock = kBlockElements<T>;
+    std::size_t size = std::min(lhs.Size(), rhs.Size());
+    T lhs_buffer[kBlock];
+    T rhs_buffer[kBlock];
+    for (std::size_t offset = 0; offset < size; offset += kBlock) {
+      std::size_t count = std::min(kBlock, size - offset);
+      const T* a = Contiguous(lhs, offset, count, lhs_buffer);
+      const T* b = Contiguous(rhs, offset, count, rhs_buffer);
+      if (std::memcmp(a, b, count * sizeof(T)) == 0) continue;
+      for (std::size_t i = 0;; ++i) {
+        if (std::memcmp(a + i, b + i, sizeof(T)) != 0) return offset + i;
+      }
+    }
+    return size;
+  }
+
+  // Streaming 64-bit hash, four independent lanes over 32-byte rounds.
+  // The result depends only on the sequence of bytes, not on how it was split into Update calls.
+  class StreamHasher {
+    static constexpr std::uint64_t kSecret[4] = {
+      0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+    };
+    static constexpr std::size_t kRound = 32;
+
+  public:
+    explicit StreamHasher(std::uint64_t seed = 0) noexcept {
+      for (std::size_t lane = 0; lane < 4; ++lane) {
+        state_[lane] = seed ^ kSecret[lane];
+      }
+    }
+
+    void Update(const void* data, std::size_t size) noexcept {
+      const auto* bytes = static_cast<const unsigned char*>(data);
+      total_ += size;
+      if (buffered_ != 0) {
+        std::size_t take = std::min(size, kRound - buffered_);
+        std::memcpy(buffer_ + buffered_, bytes, take);
+        buffered_ += take;
+        bytes += take;
+        size -= take;
+        if (buffered_ < kRound) return;
+        Round(buffer_);
+        buffered_ = 0;
+      }
+      for (; size >= kRound; bytes += kRound, size -= kRound) {
+        Round(bytes);
+      }
+      std::memcpy(buffer_, bytes, size);
+      buffered_ = size;
+    }
+
+    std::uint64_t Finish() const noexcept {
+      std::uint64_t hash = Mix(state_[0], state_[1]) ^ Mix(state_[2], state_[3]) ^ total_;
+      for (std::size_t offset = 0; offset < buffered_; offset += 8) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, buffer_ + offset, std::min<std::size_t>(8, buffered_ - offset));
+        hash = Mix(hash ^ word, kSecret[1]);
+      }
+      return Mix(hash ^ kSecret[0], total_ ^ kSecret[2]);
+    }
+
+  private:
+    static std::uint64_t Mix(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+      unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+      return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+    }
+
+    void Round(const unsigned char* block) noexcept {
+      for (std::size_t lane = 0; lane < 4; ++lane) {
+        std::uint64_t word;
+        std::memcpy(&word, block + lane * 8, 8);
+        state_[lane] = Mix(word ^ kSecret[lane], state_[lane] ^ kSecret[(lane + 1) % 4]);
+      }
+    }
+
+    std::uint64_t state_[4];
+    unsigned char buffer_[kRound] = {};
+    std::size_t buffered_ = 0;
+    std::uint64_t total_ = 0;
+  };
+
+}  // namespace detail::compare
+
+
+// Index of the first position where the views differ, or the size of the shorter one
+template <class A, class B>
+requires (detail::compare::View<A> && detail::compare::View<B>)
+std::size_t Mismatch(const A& lhs, const B& rhs) {
+  if constexpr (detail::compare::BytewiseComparable<A, B>) {
+    return detail::compare::MismatchBytes(lhs, rhs);
+  } else {
+    std::size_t size = std::min(lhs.Size(), rhs.Size());
+    for (std::size_t i = 0; i < size; ++i) {
+      if (!(lhs[i] == rhs[i])) return i;
+    }
+    return size;
+  }
+}
+
+// Same size and equal elements. Unlike Equal from SliceExpr.hpp this is a single bool, not an elementwise mask.
+template <class A, class B>
+requires (detail::compare::View<A> && detail::compare::View<B>)
+bool Equals(const A& lhs, const B& rhs) {
+  if (lhs.Size() != rhs.Size()) return false;
+  if constexpr (detail::compare::BytewiseComparable<A, B>) {
+    using T = detail::compare::ElementOf<A>;
+    if (detail::compare::StrideOf(lhs) == 1 && detail::compare::StrideOf(rhs) == 1) {
+      return lhs.Size() == 0 || std::memcmp(lhs.Data(), rhs.Data(), lhs.Size() * sizeof(T)) == 0;
+    }
+  }
+  return Mismatch(lhs, rhs) == lhs.Size();
+}
+
+// Lexicographic three-way comparison, a shorter prefix orders first
+template <class A, class B>
+requires (detail::compare::View<A> && detail::compare::View<B>)
+auto Compare(const A& lhs, const B& rhs) -> std::compare_three_way_result_t<detail::compare::ElementOf<A>, detail::compare::ElementOf<B>> {
+  using Result = std::compare_three_way_result_t<detail::compare::ElementOf<A>, detail::compare::ElementOf<B>>;
+  if constexpr (detail::compare::BytewiseComparable<A, B> && detail::compare::ByteOrdered<detail::compare::ElementOf<A>>) {
+    if (detail::compare::StrideOf(lhs) == 1 && detail::compare::StrideOf(rhs) == 1) {
+      std::size_t size = std::min(lhs.Size(), rhs.Size());
+      int result = size == 0 ? 0 : std::memcmp(lhs.Data(), rhs.Data(), size);
+      if (result != 0) return result <=> 0;
+      return lhs.Size() <=> rhs.Size();
+    }
+  }
+  std::size_t index = Mismatch(lhs, rhs);
+  if (index < lhs.Size() && index < rhs.Size()) {
+    return static_cast<Result>(lhs[index] <=> rhs[index]);
+  }
+  return lhs.Size() <=> rhs.Size();
+}
+
+// Hash of the element sequence, equal for views that are Equals regardless of their strides
+template <class V>
+requires detail::compare::View<V>
+std::uint64_t Hash(const V& view, std::uint64_t seed = 0) {
+  using T = detail::compare::ElementOf<V>;
+  detail::compare::StreamHasher hasher(seed);
+  if constexpr (detail::compare::Bytewise<T>) {
+    if (detail::compare::StrideOf(view) == 1) {
+      hasher.Update(view.Data(), view.Size() * sizeof(T));
+    } else {
+      constexpr std::size_t kBlock = detail::compare::kBlockElements<T>;
+      T buffer[kBlock];
+      for (std::size_t offset = 0; offset < view.Size(); offset += kBlock) {
+        std::size_t count = std::min(kBlock, view.Size() - offset);
+        hasher.Update(detail::compare::Contiguous(view, offset, count, buffer), count * sizeof(T));
+      }
+    }
+  } else {
+    std::hash<T> element_hash;
+    for (std::size_t i = 0; i < view.Size(); ++i) {
+      std::size_t value = element_hash(view[i]);
+      hasher.Update(&value, sizeof(value));
+    }
+  }
+  return hasher.Finish();
+}
+
+// Function objects for hashed containers keyed by views
+
+struct ViewHash {
+  template <class V>
+  requires detail::compare::View<V>
+  std::size_t operator()(const V& view) const {
+    return static_cast<std::size_t>(Hash(view));
+  }
+};
+
+struct ViewEqual {
+  template <class A, class B>
+  requires (detail::compare::View<A> && detail::compare::View<B>)
+  bool operator()(const A& lhs, const B& rhs) const {
+    return Equals(lhs, rhs);
+  }
+};
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <Span.hpp>
+#include <Slice.hpp>
+
+// Bulk copies between strided Slices and contiguous Spans.
+//
+// For compile-time strides up to kMaxShuffleStride the elements are moved in 16-byte blocks:
+// a block of `stride` vectors is loaded contiguously and the lanes of one channel
+// are picked out with constant shuffles. Dynamic strides 1..kMaxShuffleStride are dispatched
+// to the same code, other strides use a plain strided loop.
+
+
+namespace detail::strided {
+
+  inline constexpr std::ptrdiff_t kMaxShuffleStride = 4;
+  inline constexpr std::size_t kBlockBytes = 16;
+
+  // Elements are moved as raw integers of the same size
+  template <std::size_t size>
+  using Bits = std::conditional_t<size == 1, std::uint8_t,
+               std::conditional_t<size == 2, std::uint16_t,
+               std::conditional_t<size == 4, std::uint32_t, std::uint64_t>>>;
+
+  template <typename T>
+  concept Shufflable = std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+  template <typename U>
+  using Vec [[gnu::vector_size(kBlockBytes)]] = U;
+
+  template <typename U>
+  inline constexpr std::size_t kLanes = kBlockBytes / sizeof(U);
+
+  template <typename U>
+  [[gnu::always_inline]] inline Vec<U> Load(const void* data) {
+    Vec<U> result;
+    std::memcpy(&result, data, kBlockBytes);
+    return result;
+  }
+
+  template <typename U>
+  [[gnu::always_inline]] inline void Store(void* data, Vec<U> value) {
+    std::memcpy(data, &value, kBlockBytes);
+  }
+
+  template <typename U, typename F, std::size_t... L>
+  constexpr Vec<U> MakeMask(F source, std::index_sequence<L...>) {
+    return Vec<U>{static_cast<U>(source(L))...};
+  }
+
+  template <typename U, typename F>
+  constexpr Vec<U> MakeMask(F source) {
+    return MakeMask<U>(source, std::make_index_sequence<kLanes<U>>());
+  }
+
+  // Lane l of the result is lane `stride * l + channel` of the concatenation of `block`
+  template <typename U, std::ptrdiff_t stride, std::ptrdiff_t channel, std::size_t... I>
+  [[gnu::always_inline]] inline Vec<U> Pick(const Vec<U> (&block)[stride], std::index_sequence<I...>) {
+    constexpr std::size_t W = kLanes<U>;
+    constexpr auto source = [](std::size_t lane) { return stride * lane + channel; };
+    Vec<U> result = __builtin_shuffle(block[0], block[stride > 1 ? 1 : 0], MakeMask<U>([source](std::size_t lane) {
+      return source(lane) < 2 * W ? source(lane) : 0;
+    }));
+    // Fold in the remaining vectors, keeping lanes that are already in place
+    ((result = __builtin_shuffle(result, block[I + 2], MakeMask<U>([source](std::size_t lane) {
+      return source(lane) / W == I + 2 ? W + source(lane) % W : lane;
+    }))), ...);
+    return result;
+  }
+
+  // Element k of the block is element k / stride of plane k % stride
+  template <typename U, std::ptrdiff_t stride, std::size_t vector, std::size_t... I>
+  [[gnu::always_inline]] inline Vec<U> Merge(const Vec<U> (&planes)[stride], std::index_sequence<I...>) {
+    constexpr std::size_t W = kLanes<U>;
+    constexpr auto plane = [](std::size_t lane) { return (vector * W + lane) % stride; };
+    constexpr auto index = [](std::size_t lane) { return (vector * W + lane) / stride; };
+    Vec<U> result = __builtin_shuffle(planes[0], planes[stride > 1 ? 1 : 0], MakeMask<U>([plane, index](std::size_t lane) {
+      return plane(lane) < 2 ? plane(lane) * W + index(lane) : 0;
+    }));
+    ((result = __builtin_shuffle(result, planes[I + 2], MakeMask<U>([plane, index](std::size_t lane) {
+      return plane(lane) == I + 2 ? W + index(lane) : lane;
+    }))), ...);
+    return result;
+  }
+
+  // Replaces lanes of `block` that belong to `channel` with consecutive lanes of `value`
+  template <typename U, std::ptrdiff_t stride, std::ptrdiff_t channel, std::size_t vector>
+  [[gnu::always_inline]] inline Vec<U> Blend(Vec<U> block, Vec<U> value) {
+    constexpr std::size_t W = kLanes<U>;
+    return __builtin_shuffle(block, value, MakeMask<U>([](std::size_t lane) {
+      std::size_t k = vector * W + lane;
+      return k % stride == static_cast<std::size_t>(channel) ? W + k / stride : lane;
+    }));
+  }
+
+  template <std::ptrdiff_t stride>
+  using FoldSequence = std::make_index_sequence<(stride > 2 ? stride - 2 : 0)>;
+
+  // Number of leading elements that can be processed in whole blocks without
+  // touching memory after the last element of the strided range
+  template <typename U, std::ptrdiff_t stride>
+  constexpr std::size_t VectorizableCount(std::size_t size) {
+    constexpr std::size_t W = kLanes<U>;
+    if (size == 0) return 0;
+    // a block starting at element i reads memory up to offset (i + W) * stride - 1
+    std::size_t last = (size - 1) * stride;
+    std::size_t blocks = last + 1 < W * stride ? 0 : (last + 1 - W * stride) / (W * stride) + 1;
+    return blocks * W;
+  }
+
+  // dst[i] = src[i * stride]
+  template <std::ptrdiff_t stride, typename T>
+  void Gather(const T* src, T* dst, std::size_t size) {
+    using U = Bits<sizeof(T)>;
+    constexpr std::size_t W = kLanes<U>;
+    std::size_t i = 0;
+    for (std::size_t vectorized = VectorizableCount<U, stride>(size); i < vectorized; i += W) {
+      Vec<U> block[stride];
+      for (std::ptrdiff_t v = 0; v < stride; ++v) {
+        block[v] = Load<U>(src + i * stride + v * W);
+      }
+      Store<U>(dst + i, Pick<U, stride, 0>(block, FoldSequence<stride>()));
+    }
+    for (; i < size; ++i) {
+      dst[i] = src[i * stride];
+    }
+  }
+
+  // dst[i * stride] = src[i], elements of dst in between are preserved
+  template <std::ptrdiff_t stride, typename T>
+  void Scatter(const T* src, T* dst, std::size_t size) {
+    using U = Bits<sizeof(T)>;
+    constexpr std::size_t W = kLanes<U>;
+    std::size_t i = 0;
+    for (std::size_t vectorized = VectorizableCount<U, stride>(size); i < vectorized; i += W) {
+      Vec<U> value = Load<U>(src + i);
+      [&]<std::size_t... V>(std::index_sequence<V...>) {
+        ((Store<U>(dst + i * stride + V * W, Blend<U, stride, 0, V>(Load<U>(dst + i * stride + V * W), value))), ...);
+      }(std::make_index_sequence<stride>());
+    }
+    for (; i < size; ++i) {
+      dst[i * stride] = src[i];
+    }
+  }
+
+  // planes[c][i] = src[i * channels + c]
+  template <std::ptrdiff_t channels, typename T>
+  void Deinterleave(const T* src, const std::array<T*, channels>& planes, std::size_t size) {
+    using U = Bits<sizeof(T)>;
+    constexpr std::size_t W = kLanes<U>;
+    std::size_t i = 0;
+    for (; i + W <= size; i += W) {
+      Vec<U> block[channels];
+      for (std::ptrdiff_t v = 0; v < channels; ++v) {
+        block[v] = Load<U>(src + i * channels + v * W);
+      }
+      [&]<std::size_t... C>(std::index_sequence<C...>) {
+        ((Store<U>(planes[C] + i, Pick<U, channels, C>(block, FoldSequence<channels>()))), ...);
+      }(std::make_index_sequence<channels>());
+    }
+    for (; i < size; ++i) {
+      for (std::ptrdiff_t c = 0; c < channels; ++c) {
+        planes[c][i] = src[i * channels + c];
+      }
+    }
+  }
+
+  // dst[i * channels + c] = planes[c][i]
+  template <std::ptrdiff_t channels, typename T>
+  void Interleave(const std::array<const T*, channels>& planes, T* dst, std::size_t size) {
+    using U = Bits<sizeof(T)>;
+    constexpr std::size_t W = kLanes<U>;
+    std::size_t i = 0;
+    for (; i + W <= size; i += W) {
+      Vec<U> block[channels];
+      for (std::ptrdiff_t c = 0; c < channels; ++c) {
+        block[c] = Load<U>(planes[c] + i);
+      }
+      [&]<std::size_t... V>(std::index_sequence<V...>) {
+        ((Store<U>(dst + i * channels + V * W, Merge<U, channels, V>(block, FoldSequence<channels>()))), ...);
+      }(std::make_index_sequence<channels>());
+    }
+    for (; i < size; ++i) {
+      for (std::ptrdiff_t c = 0; c < channels; ++c) {
+        dst[i * channels + c] = planes[c][i];
+      }
+    }
+  }
+
+  // Strided loops for the other strides, the stride is kept in a register
+
+  template <typename T>
+  void GatherDynamic(const T* src, T* dst, std::size_t size, std::ptrdiff_t stride) {
+    for (std::size_t i = 0; i < size; ++i, src += stride) {
+      dst[i] = *src;
+    }
+  }
+
+  template <typename T>
+  void ScatterDynamic(const T* src, T* dst, std::size_t size, std::ptrdiff_t stride) {
+    for (std::size_t i = 0; i < size; ++i, dst += stride) {
+      *dst = src[i];
+    }
+  }
+
+  // Calls f(std::integral_constant<std::ptrdiff_t, s>) for the stride if it has a vectorized path,
+  // returns false otherwise
+  template <typename F>
+  bool WithStaticStride(std::ptrdiff_t stride, F&& f) {
+    switch (stride) {
+      case 2:
+        f(std::integral_constant<std::ptrdiff_t, 2>());
+        return true;
+      case 3:
+        f(std::integral_constant<std::ptrdiff_t, 3>());
+        return true;
+      case 4:
+        f(std::integral_constant<std::ptrdiff_t, 4>());
+        return true;
+      default:
+        return false;
+    }
+  }
+
+}  // namespace detail::strided
+
+
+// Copies the elements of the slice into a contiguous buffer of the same size
+template <class T, std::size_t extent, std::ptrdiff_t stride, class U, std::size_t out_extent>
+requires std::same_as<std::remove_cv_t<T>, U>
+void CopyTo(const Slice<T, extent, stride>& source, const Span<U, out_extent>& destination) {
+  assert(destination.Size() >= source.Size());
+  const U* src = source.Data();
+  U* dst = destination.Data();
+  std::size_t size = source.Size();
+  std::ptrdiff_t step = source.Stride();
+
+  if constexpr (detail::strided::Shufflable<U>) {
+    if constexpr (stride != dynamic_stride && stride > 1 && stride <= detail::strided::kMaxShuffleStride) {
+      detail::strided::Gather<stride>(src, dst, size);
+      return;
+    }
+    if (step == 1) {
+      // Empty views may hold null, which memcpy does not accept even for zero bytes
+      if (size != 0) {
+        std::memcpy(dst, src, size * sizeof(U));
+      }
+      return;
+    }
+    if (detail::strided::WithStaticStride(step, [&](auto s) { detail::strided::Gather<decltype(s)::value>(src, dst, size); })) {
+      return;
+    }
+  }
+  detail::strided::GatherDynamic(src, dst, size, step);
+}
+
+// Fills the slice from a contiguous buffer, elements between the slice elements are left untouched
+template <class T, std::size_t extent, std::ptrdiff_t stride, class U, std::size_t in_extent>
+requires (!std::is_const_v<T> && std::same_as<T, std::remove_cv_t<U>>)
+void CopyFrom(const Slice<T, extent, stride>& destination, const Span<U, in_extent>& source) {
+  assert(source.Size() >= destination.Size());
+  const T* src = source.Data();
+  T* dst = destination.Data();
+  std::size_t size = destination.Size();
+  std::ptrdiff_t step = destination.Stride();
+
+  if constexpr (detail::strided::Shufflable<T>) {
+    if constexpr (stride != dynamic_stride && stride > 1 && stride <= detail::strided::kMaxShuffleStride) {
+      detail::strided::Scatter<stride>(src, dst, size);
+      return;
+    }
+    if (step == 1) {
+      // Empty views may hold null, which memcpy does not accept even for zero bytes
+      if (size != 0) {
+        std::memcpy(dst, src, size * sizeof(T));
+      }
+      return;
+    }
+    if (detail::strided::WithStaticStride(step, [&](auto s) { detail::strided::Scatter<decltype(s)::value>(src, dst, size); })) {
+      return;
+    }
+  }
+  detail::strided::ScatterDynamic(src, dst, size, step);
+}
+
+// Splits `channels`-way interleaved data into planes, planes[c][i] = interleaved[i * channels + c]
+template <std::size_t channels, class T, std::size_t in_extent>
+requires (channels > 0)
+void Deinterleave(const Span<const T, in_extent>& interleaved, const std::array<Span<T>, channels>& planes) {
+  std::size_t size = interleaved.Size() / channels;
+  std::array<T*, channels> outputs;
+  for (std::size_t c = 0; c < channels; ++c) {
+    assert(planes[c].Size() >= size);
+    outputs[c] = planes[c].Data();
+  }
+  if constexpr (detail::strided::Shufflable<T> && channels > 1 && channels <= detail::strided::kMaxShuffleStride) {
+    detail::strided::Deinterleave<channels>(interleaved.Data(), outputs, size);
+  } else {
+    for (std::size_t c = 0; c < channels; ++c) {
+      detail::strided::GatherDynamic(interleaved.Data() + c, outputs[c], size, channels);
+    }
+  }
+}
+
+// Inverse of Deinterleave, interleaved[i * channels + c] = planes[c][i]
+template <std::size_t channels, class T, std::size_t out_extent>
+requires (channels > 0 && !std::is_const_v<T>)
+void Interleave(const std::array<Span<const T>, channels>& planes, const Span<T, out_extent>& interleaved) {
+  std::size_t size = interleaved.Size() / channels;
+  std::array<const T*, channels> inputs;
+  for (std::size_t c = 0; c < channels; ++c) {
+    assert(planes[c].Size() >= size);
+    inputs[c] = planes[c].Data();
+  }
+  if constexpr (detail::strided::Shufflable<T> && channels > 1 && channels <= detail::strided::kMaxShuffleStride) {
+    detail::strided::Interleave<channels>(inputs, interleaved.Data(), size);
+  } else {
+    for (std::size_t c = 0; c < channels; ++c) {
+      detail::strided::ScatterDynamic(inputs[c], interleaved.Data() + c, size, channels);
+    }
+  }
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <Span.hpp>
+#include <Slice.hpp>
+
+// Lazy elementwise expressions over Slice and Span.
+//
+//   Assign(out, a * b + c);
+//   Assign(mask, Select(Less(a, 0.0), -a, a));
+//
+// Arithmetic operators on views build an expression tree, nothing is computed until Assign,
+// which evaluates the whole tree in one pass. If every view involved has compile-time stride 1
+// the loop runs over raw pointers, so the compiler can vectorize it.
+// Comparisons are named functions (Less, Equal, ...) since Slice already has operator==.
+
+
+namespace detail::expr {
+
+  struct ExprBase {};
+
+  template <class E>
+  concept Expression = std::derived_from<std::remove_cvref_t<E>, ExprBase>;
+
+  template <class V>
+  struct ViewTraits : std::false_type {};
+
+  template <class T, std::size_t extent, std::ptrdiff_t stride>
+  struct ViewTraits<Slice<T, extent, stride>> : std::true_type {
+    using Element = T;
+    static constexpr bool contiguous = stride == 1;
+  };
+
+  template <class T, std::size_t extent>
+  struct ViewTraits<Span<T, extent>> : std::true_type {
+    using Element = T;
+    static constexpr bool contiguous = true;
+  };
+
+  template <class V>
+  concept View = ViewTraits<std::remove_cvref_t<V>>::value;
+
+  template <class S>
+  concept Scalar = std::is_arithmetic_v<std::remove_cvref_t<S>>;
+
+  template <class O>
+  concept Operand = Expression<O> || View<O> || Scalar<O>;
+
+  // At least one side must be an expression or a view, otherwise built-in operators apply
+  template <class L, class R>
+  concept ExpressionOperands = Operand<L> && Operand<R> && !(Scalar<L> && Scalar<R>);
+
+  // Leaves
+
+  template <class T, bool contiguous>
+  class Leaf : public ExprBase {
+  public:
+    static constexpr bool kContiguous = contiguous;
+
+    Leaf(const T* data, std::size_t size, std::ptrdiff_t stride) : data_(data), size_(size), stride_(stride) {}
+
+    std::size_t Size() const noexcept {
+      return size_;
+    }
+
+    [[gnu::always_inline]] const T& operator[](std::size_t index) const noexcept {
+      if constexpr (contiguous) {
+        return data_[index];
+      } else {
+        return data_[static_cast<std::ptrdiff_t>(index) * stride_];
+      }
+    }
+
+  private:
+    const T* data_;
+    std::size_t size_;
+    std::ptrdiff_t stride_;
+  };
+
+  template <class T>
+  class Constant : public ExprBase {
+  public:
+    static constexpr bool kContiguous = true;
+
+    explicit Constant(T value) : value_(value) {}
+
+    // Constants adapt to the size of the other operands
+    std::size_t Size() const noexcept {
+      return std::dynamic_extent;
+    }
+
+    [[gnu::always_inline]] T operator[](std::size_t) const noexcept {
+      return value_;
+    }
+
+  private:
+    T value_;
+  };
+
+  // Nodes
+
+  inline std::size_t CommonSize(std::size_t lhs, std::size_t rhs) {
+    if (lhs == std::dynamic_extent) return rhs;
+    assert(rhs == std::dynamic_extent || lhs == rhs);
+    return lhs;
+  }
+
+  template <class F, class E>
+  class Unary : public ExprBase {
+  public:
+    static constexpr bool kContiguous = E::kContiguous;
+
+    Unary(F f, E e) : f_(std::move(f)), e_(std::move(e)) {}
+
+    std::size_t Size() const noexcept {
+      return e_.Size();
+    }
+
+    [[gnu::always_inline]] decltype(auto) operator[](std::size_t index) const {
+      return f_(e_[index]);
+    }
+
+  private:
+    [[no_unique_address]] F f_;
+    E e_;
+  };
+
+  template <class Op, class L, class R>
+  class Binary : public ExprBase {
+  public:
+    static constexpr bool kContiguous = L::kContiguous && R::kContiguous;
+
+    Binary(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    std::size_t Size() const noexcept {
+      return CommonSize(lhs_.Size(), rhs_.Size());
+    }
+
+    [[gnu::always_inline]] decltype(auto) operator[](std::size_t index) const {
+      return Op{}(lhs_[index], rhs_[index]);
+    }
+
+  private:
+    L lhs_;
+    R rhs_;
+  };
+
+  template <class C, class A, class B>
+  class Select : public ExprBase {
+  public:
+    static constexpr bool kContiguous = C::kContiguous && A::kContiguous && B::kContiguous;
+
+    Select(C condition, A on_true, B on_false)
+      : condition_(std::move(condition)), on_true_(std::move(on_true)), on_false_(std::move(on_false)) {
+
+    }
+
+    std::size_t Size() const noexcept {
+      return CommonSize(condition_.Size(), CommonSize(on_true_.Size(), on_false_.Size()));
+    }
+
+    // Both branches are evaluated, which keeps the loop free of branches
+    [[gnu::always_inline]] auto operator[](std::size_t index) const {
+      auto a = on_true_[index];
+      auto b = on_false_[index];
+      return condition_[index] ? a : b;
+    }
+
+  private:
+    C condition_;
+    A on_true_;
+    B on_false_;
+  };
+
+  // Turns any operand into an expression node
+
+  template <Expression E>
+  std::remove_cvref_t<E> Lift(E&& e) {
+    return std::forward<E>(e);
+  }
+
+  template <View V>
+  auto Lift(const V& view) {
+    using Traits = ViewTraits<std::remove_cvref_t<V>>;
+    using Element = std::remove_cv_t<typename Traits::Element>;
+    std::ptrdiff_t stride = 1;
+    if constexpr (requires { view.Stride(); }) {
+      stride = view.Stride();
+    }
+    return Leaf<Element, Traits::contiguous>(view.Data(), view.Size(), stride);
+  }
+
+  template <Scalar S>
+  Constant<std::remove_cvref_t<S>> Lift(S value) {
+    return Constant<std::remove_cvref_t<S>>(value);
+  }
+
+  template <class O>
+  using Lifted = decltype(Lift(std::declval<O>()));
+
+  template <class Op, class L, class R>
+  Binary<Op, Lifted<L>, Lifted<R>> MakeBinary(L&& lhs, R&& rhs) {
+    return Binary<Op, Lifted<L>, Lifted<R>>(Lift(std::forward<L>(lhs)), Lift(std::forward<R>(rhs)));
+  }
+
+}  // namespace detail::expr
+
+
+// Arithmetic
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto operator+(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::plus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto operator-(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::minus<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto operator*(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::multiplies<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto operator/(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::divides<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class E>
+requires (detail::expr::Expression<E> || detail::expr::View<E>)
+auto operator-(E&& e) {
+  return detail::expr::Unary<std::negate<>, detail::expr::Lifted<E>>({}, detail::expr::Lift(std::forward<E>(e)));
+}
+
+// Comparisons
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto Less(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::less<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto LessEqual(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::less_equal<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto Greater(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::greater<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto GreaterEqual(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::greater_equal<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto Equal(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::equal_to<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R>
+requires detail::expr::ExpressionOperands<L, R>
+auto NotEqual(L&& lhs, R&& rhs) {
+  return detail::expr::MakeBinary<std::not_equal_to<>>(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+// Selection and user functions
+
+template <class C, class A, class B>
+requires (detail::expr::Operand<C> && detail::expr::Operand<A> && detail::expr::Operand<B>)
+auto Select(C&& condition, A&& on_true, B&& on_false) {
+  using namespace detail::expr;
+  return detail::expr::Select<Lifted<C>, Lifted<A>, Lifted<B>>(
+    Lift(std::forward<C>(condition)), Lift(std::forward<A>(on_true)), Lift(std::forward<B>(on_false)));
+}
+
+// f(element) for every element of e
+template <class F, class E>
+requires (detail::expr::Expression<E> || detail::expr::View<E>)
+auto Apply(F f, E&& e) {
+  return detail::expr::Unary<F, detail::expr::Lifted<E>>(std::move(f), detail::expr::Lift(std::forward<E>(e)));
+}
+
+// Evaluation
+
+// out[i] = e[i] for every i, in a single pass
+template <class Out, class E>
+requires (detail::expr::View<Out> && (detail::expr::Expression<E> || detail::expr::View<E>))
+void Assign(const Out& out, E&& e) {
+  auto expr = detail::expr::Lift(std::forward<E>(e));
+  std::size_t size = out.Size();
+  assert(expr.Size() == std::dynamic_extent || expr.Size() == size);
+
+  auto* data = out.Data();
+  constexpr bool out_contiguous = detail::expr::ViewTraits<std::remove_cvref_t<Out>>::contiguous;
+  if constexpr (out_contiguous && decltype(expr)::kContiguous) {
+    for (std::size_t i = 0; i < size; ++i) {
+      data[i] = expr[i];
+    }
+  } else {
+    std::ptrdiff_t stride = 1;
+    if constexpr (requires { out.Stride(); }) {
+      stride = out.Stride();
+    }
+    for (std::size_t i = 0; i < size; ++i, data += stride) {
+      *data = expr[i];
+    }
+  }
+}
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
 #include <utility>
 #include <type_lists.hpp>
 #include <value_types.hpp>
@@ -33,33 +40,126 @@ using Fib = type_lists::Map
 
 // Primes
 namespace detail {
-    template <int N, int D>
-    struct IsPrimeHelper {
-        static constexpr bool Value = (N % D == 0) ? false : IsPrimeHelper<N, D - 1>::Value;
-    };
+    // Trial division up to sqrt(n) in a constexpr loop, so no recursion per divisor
+    constexpr bool IsPrimeNumber(int n) {
+        if (n < 2) return false;
+        for (int d = 2; d <= n / d; ++d) {
+            if (n % d == 0) return false;
+        }
+        return true;
+    }
 
-    template <int N>
-    struct IsPrimeHelper<N, 1> {
-        static constexpr bool Value = true;
-    };
+    constexpr int NextPrimeNumber(int n) {
+        do {
+            ++n;
+        } while (!IsPrimeNumber(n));
+        return n;
+    }
 
     template <VTag<int> tag>
-    struct IsPrime {
-        static constexpr bool Value = IsPrimeHelper<tag::Value, tag::Value - 1>::Value;
-    };
-
-    template <>
-    struct IsPrime<ValueTag<0>> {
-        static constexpr bool Value = false;
-    };
-
-    template <>
-    struct IsPrime<ValueTag<1>> {
-        static constexpr bool Value = false;
-    };
+    using NextPrime = ValueTag<NextPrimeNumber(tag::Value)>;
 }
 
-using Primes = type_lists::Filter
-               < detail::IsPrime
-               , Nats
-               >;
+// Steps from prime to prime instead of filtering Nats, so composites are never instantiated
+using Primes = type_lists::Iterate<detail::NextPrime, value_types::ValueTag<2>>;
+
+// ToArray
+namespace detail {
+    template <typename... Ts>
+    constexpr auto ToArrayImpl(type_tuples::TTuple<Ts...>) {
+        using Value = std::common_type_t<std::remove_cv_t<decltype(Ts::Value)>...>;
+        return std::array<Value, sizeof...(Ts)>{Ts::Value...};
+    }
+
+    constexpr auto ToArrayImpl(type_tuples::TTuple<>) {
+        return std::array<int, 0>{};
+    }
+}
+
+// Values of a finite list of ValueTags, e.g. ToArray<type_lists::Take<40, Fib>>
+template <type_lists::TypeList TL>
+inline constexpr auto ToArray = detail::ToArrayImpl(type_lists::ToTuple<TL>());
+
+// IterateTable
+//
+// The first N values of the sequence Init, Next(Init), Next(Next(Init)), ... passed through Project,
+// the value-level counterpart of ToArray<Take<N, Map<Project, Iterate<Next, Init>>>>.
+// It is evaluated in a constexpr loop, so tables of tens of thousands of entries stay cheap:
+//
+//   constexpr auto fib = IterateTable<90, [](auto p) { return std::pair(p.second, p.first + p.second); },
+//                                     std::pair<std::uint64_t, std::uint64_t>(0, 1),
+//                                     [](auto p) { return p.first; }>;
+template <std::size_t N, auto Next, auto Init, auto Project = std::identity()>
+inline constexpr auto IterateTable = [] {
+    std::array<std::remove_cvref_t<decltype(Project(Init))>, N> table{};
+    auto state = Init;
+    for (std::size_t i = 0; i < N; ++i) {
+        table[i] = Project(state);
+        if (i + 1 < N) state = Next(state);
+    }
+    return table;
+}();
+
+// PrimeTable
+namespace detail {
+    // Constexpr loops are capped (-fconstexpr-loop-limit), so long loops run in nested blocks
+    constexpr std::size_t kSieveBlock = std::size_t{1} << 16;
+
+    // Natural logarithm: x = 2^k * m with m in [1, 2), ln m = 2 atanh((m - 1) / (m + 1))
+    constexpr double Log(double x) {
+        int k = 0;
+        for (; x >= 2; x /= 2) ++k;
+        double y = (x - 1) / (x + 1);
+        double term = y;
+        double sum = 0;
+        for (int i = 1; i < 40; i += 2, term *= y * y) {
+            sum += term / i;
+        }
+        return k * 0.6931471805599453 + 2 * sum;
+    }
+
+    // Bound on the n-th prime: p_n < n (ln n + ln ln n) for n >= 6 (Rosser)
+    constexpr std::size_t PrimeBound(std::size_t n) {
+        if (n < 6) return 13;
+        double log = Log(static_cast<double>(n));
+        return static_cast<std::size_t>(static_cast<double>(n) * (log + Log(log))) + 1;
+    }
+
+    // Sieve of Eratosthenes over the odd numbers, bit i of the sieve stands for 2i + 1.
+    // The bits are reached through a raw pointer: every std::array::operator[] is a call
+    // that the constant evaluator has to interpret.
+    template <std::size_t N>
+    constexpr std::array<int, N> SievePrimes() {
+        constexpr std::size_t bits = PrimeBound(N) / 2 + 1;
+        std::array<std::uint64_t, (bits + 63) / 64> words{};
+        std::uint64_t* composite = words.data();
+        composite[0] = 1;
+        for (std::size_t p = 3; p * p < 2 * bits; p += 2) {
+            if (composite[p / 128] >> (p / 2 % 64) & 1) continue;
+            for (std::size_t block = p * p / 2; block < bits; block += p * kSieveBlock) {
+                std::size_t end = std::min(bits, block + p * kSieveBlock);
+                for (std::size_t bit = block; bit < end; bit += p) {
+                    composite[bit / 64] |= std::uint64_t{1} << (bit % 64);
+                }
+            }
+        }
+
+        std::array<int, N> primes{};
+        int* out = primes.data();
+        std::size_t count = 0;
+        if (count < N) out[count++] = 2;
+        for (std::size_t word = 0; word < words.size() && count < N; ++word) {
+            for (std::uint64_t left = ~composite[word]; left != 0 && count < N; left &= left - 1) {
+                std::size_t bit = word * 64 + static_cast<std::size_t>(std::countr_zero(left));
+                if (bit >= bits) break;
+                out[count++] = static_cast<int>(2 * bit + 1);
+            }
+        }
+        return primes;
+    }
+}
+
+// The first N primes, the table form of ToArray<Take<N, Primes>>.
+// 50000 primes take a few seconds with GCC's default limits, larger tables need -fconstexpr-ops-limit.
+template <std::size_t N>
+inline constexpr std::array<int, N> PrimeTable = detail::SievePrimes<N>();
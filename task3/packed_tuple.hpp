@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <type_lists.hpp>
+
+// A tuple that lays its elements out in padding-minimizing order.
+//
+//   PackedTuple<bool, std::int64_t, std::int16_t, bool> t(true, 42, 7, false);
+//   t.get<1>() = 43;                        // indices are the declared ones
+//   auto& [flag, id, port, dirty] = t;      // structured bindings work too
+//   static_assert(decltype(t)::saved_bytes == 8);   // 24 bytes as declared, 16 packed
+//
+// Elements are stored by decreasing alignment (declaration order among equals), so no padding
+// is needed between them and only the tail is rounded up to the alignment of the tuple.
+// Empty elements take no space. Element I lives in the base Leaf<I, T>, so get<I>
+// is a plain base-to-member access and costs nothing at run time.
+
+namespace packed_tuples
+{
+
+namespace detail {
+    template <std::size_t I, typename T>
+    struct Leaf {
+        [[no_unique_address]] T value;
+
+        constexpr Leaf() : value() {
+        }
+
+        template <typename Args>
+        constexpr Leaf(std::in_place_t, Args&& args) : value(std::get<I>(std::forward<Args>(args))) {
+        }
+
+        friend constexpr bool operator==(const Leaf&, const Leaf&) = default;
+    };
+
+    template <typename T>
+    constexpr std::size_t kStoredSize = std::is_empty_v<T> ? 0 : sizeof(T);
+
+    // Declared positions sorted by decreasing alignment, stable, empty types last
+    template <typename... Ts>
+    constexpr std::array<std::size_t, sizeof...(Ts)> PackedOrder() {
+        constexpr std::size_t n = sizeof...(Ts);
+        std::array<std::size_t, n> rank = {(std::is_empty_v<Ts> ? 0 : alignof(Ts))...};
+        std::array<std::size_t, n> order{};
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t j = i;
+            for (; j > 0 && rank[order[j - 1]] < rank[i]; --j) {
+                order[j] = order[j - 1];
+            }
+            order[j] = i;
+        }
+        return order;
+    }
+
+    // Size of a plain struct with the elements in declaration order
+    template <typename... Ts>
+    constexpr std::size_t DeclaredSize() {
+        std::size_t size = 0;
+        std::size_t alignment = 1;
+        ((size = (size + alignof(Ts) - 1) / alignof(Ts) * alignof(Ts) + sizeof(Ts),
+          alignment = std::max(alignment, alignof(Ts))), ...);
+        return std::max<std::size_t>((size + alignment - 1) / alignment * alignment, 1);
+    }
+
+    // The leaf stored at position K
+    template <std::size_t K, typename... Ts>
+    using StoredLeaf = Leaf<PackedOrder<Ts...>()[K], type_lists::At<PackedOrder<Ts...>()[K], type_lists::FromTuple<type_tuples::TTuple<Ts...>>>>;
+
+    template <typename Types, typename Positions>
+    struct Storage;
+
+    template <typename... Ts, std::size_t... K>
+    struct Storage<type_tuples::TTuple<Ts...>, std::index_sequence<K...>>
+        : StoredLeaf<K, Ts...>... {
+
+        constexpr Storage() = default;
+
+        template <typename Args>
+        constexpr Storage(std::in_place_t, Args&& args)
+            : StoredLeaf<K, Ts...>(std::in_place, std::forward<Args>(args))... {
+        }
+
+        friend constexpr bool operator==(const Storage&, const Storage&) = default;
+    };
+}
+
+template <typename... Ts>
+class PackedTuple : private detail::Storage<type_tuples::TTuple<Ts...>, std::make_index_sequence<sizeof...(Ts)>> {
+    using Base = detail::Storage<type_tuples::TTuple<Ts...>, std::make_index_sequence<sizeof...(Ts)>>;
+
+public:
+    using Types = type_lists::FromTuple<type_tuples::TTuple<Ts...>>;
+
+    template <std::size_t I>
+    using Element = type_lists::At<I, Types>;
+
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    // Report
+
+    // Declared index of the element stored at each position
+    static constexpr std::array<std::size_t, size> order = detail::PackedOrder<Ts...>();
+    // sizeof of a struct with the same members in declaration order
+    static constexpr std::size_t declared_size = detail::DeclaredSize<Ts...>();
+    static constexpr std::size_t packed_size = sizeof(Base);
+    static constexpr std::size_t saved_bytes = declared_size > packed_size ? declared_size - packed_size : 0;
+    static constexpr std::size_t padding_bytes = packed_size - (detail::kStoredSize<Ts> + ... + 0);
+
+    constexpr PackedTuple() = default;
+
+    template <typename... Args>
+    requires (sizeof...(Args) == size && size > 0 && (std::is_constructible_v<Ts, Args&&> && ...))
+    constexpr explicit(!(std::is_convertible_v<Args&&, Ts> && ...)) PackedTuple(Args&&... args)
+        : Base(std::in_place, std::forward_as_tuple(std::forward<Args>(args)...)) {
+    }
+
+    // Element I in declaration order
+
+    template <std::size_t I>
+    constexpr Element<I>& get() & noexcept {
+        return static_cast<detail::Leaf<I, Element<I>>&>(*this).value;
+    }
+
+    template <std::size_t I>
+    constexpr const Element<I>& get() const& noexcept {
+        return static_cast<const detail::Leaf<I, Element<I>>&>(*this).value;
+    }
+
+    template <std::size_t I>
+    constexpr Element<I>&& get() && noexcept {
+        return std::move(static_cast<detail::Leaf<I, Element<I>>&>(*this).value);
+    }
+
+    friend constexpr bool operator==(const PackedTuple&, const PackedTuple&) = default;
+};
+
+namespace detail {
+    template <typename TT>
+    struct PackedTupleOf;
+
+    template <typename... Ts>
+    struct PackedTupleOf<type_tuples::TTuple<Ts...>> {
+        using Type = PackedTuple<Ts...>;
+    };
+}
+
+// PackedTuple of the types of a finite type list
+template <type_lists::TypeList TL>
+using PackedTupleOf = typename detail::PackedTupleOf<type_lists::ToTuple<TL>>::Type;
+
+} // namespace packed_tuples
+
+
+template <typename... Ts>
+struct std::tuple_size<packed_tuples::PackedTuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct std::tuple_element<I, packed_tuples::PackedTuple<Ts...>> {
+    using type = typename packed_tuples::PackedTuple<Ts...>::template Element<I>;
+};
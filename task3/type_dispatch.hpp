@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <type_lists.hpp>
+
+// Dispatch over closed sets of types given as finite type lists.
+//
+//   using Shapes = type_lists::FromTuple<type_tuples::TTuple<Circle, Square, Polygon>>;
+//
+//   Dispatch<Shapes>(kind, [](auto tag) { return decltype(tag)::type::kCorners; });
+//
+//   Variant<Shapes> shape = Square{2};
+//   double area = Visit([](const auto& s) { return s.Area(); }, shape);
+//   bool hit = Visit(Intersects{}, shape, other);   // one table of 3 * 3 entries
+//
+// Every dispatch is a single load from a constexpr table of function pointers followed by
+// one indirect call, whatever the number of types or visited variants. Visiting several variants
+// indexes one flattened table, so it is still a single call instead of one per variant.
+// Variant stores its discriminator in the smallest unsigned type that can hold it.
+
+namespace type_dispatch
+{
+
+namespace detail {
+    template <typename TT>
+    struct Alternatives;
+
+    template <typename... Ts>
+    struct Alternatives<type_tuples::TTuple<Ts...>> {
+        static constexpr std::size_t size = sizeof...(Ts);
+
+        template <std::size_t I>
+        using At = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        template <typename U>
+        static constexpr std::size_t count = (std::size_t{std::is_same_v<U, Ts>} + ... + 0);
+
+        // Position of U, size if U is not an alternative
+        template <typename U>
+        static constexpr std::size_t index_of = [] {
+            std::array<bool, size> same = {std::is_same_v<U, Ts>...};
+            for (std::size_t i = 0; i < size; ++i) {
+                if (same[i]) return i;
+            }
+            return size;
+        }();
+
+        static constexpr std::size_t max_size = std::max({sizeof(Ts)...});
+        static constexpr std::size_t max_align = std::max({alignof(Ts)...});
+
+        static constexpr bool distinct = ((count<Ts> == 1) && ...);
+        static constexpr bool nothrow_movable = (std::is_nothrow_move_constructible_v<Ts> && ...);
+        static constexpr bool copyable = (std::is_copy_constructible_v<Ts> && ...);
+        static constexpr bool copy_assignable = copyable && (std::is_copy_assignable_v<Ts> && ...);
+        static constexpr bool move_assignable = (std::is_move_assignable_v<Ts> && ...);
+        static constexpr bool trivially_copyable = (std::is_trivially_copyable_v<Ts> && ...);
+        static constexpr bool trivially_destructible = (std::is_trivially_destructible_v<Ts> && ...);
+    };
+
+    template <type_lists::TypeList TL>
+    using AlternativesOf = Alternatives<type_lists::ToTuple<TL>>;
+
+    template <std::size_t N>
+    using SmallestIndex =
+        std::conditional_t<N - 1 <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+        std::conditional_t<N - 1 <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+        std::conditional_t<N - 1 <= std::numeric_limits<std::uint32_t>::max(), std::uint32_t,
+        std::size_t>>>;
+
+    // Dispatch
+    template <typename R, typename F, typename T>
+    R CallWithType(F&& visitor) {
+        return std::forward<F>(visitor)(std::type_identity<T>());
+    }
+
+    template <typename F, typename T, typename... Ts>
+    decltype(auto) Dispatch(std::size_t index, F&& visitor, type_tuples::TTuple<T, Ts...>) {
+        using R = decltype(std::forward<F>(visitor)(std::type_identity<T>()));
+        static constexpr R (*kTable[])(F&&) = {&CallWithType<R, F, T>, &CallWithType<R, F, Ts>...};
+        return kTable[index](std::forward<F>(visitor));
+    }
+
+    // Visit
+    template <typename V>
+    concept IsVariant = requires { typename std::remove_cvref_t<V>::IsVariantTag; };
+
+    // Alternative I of a variant with the value category of V
+    template <std::size_t I, typename V>
+    decltype(auto) GetAt(V&& variant) {
+        using Alternative = typename std::remove_cvref_t<V>::template Alternative<I>;
+        return std::forward<V>(variant).template Get<Alternative>();
+    }
+
+    // Index of every variant in the flattened table entry Flat, the last variant varies fastest
+    template <std::size_t Flat, std::size_t... Sizes>
+    constexpr std::array<std::size_t, sizeof...(Sizes)> Unflatten() {
+        std::array<std::size_t, sizeof...(Sizes)> sizes = {Sizes...};
+        std::array<std::size_t, sizeof...(Sizes)> indices{};
+        std::size_t rest = Flat;
+        for (std::size_t i = sizes.size(); i-- > 0;) {
+            indices[i] = rest % sizes[i];
+            rest /= sizes[i];
+        }
+        return indices;
+    }
+
+    template <typename R, typename F, typename... Vs>
+    struct VisitTable {
+        template <std::size_t Flat>
+        static R Call(F&& visitor, Vs&&... variants) {
+            constexpr auto indices = Unflatten<Flat, std::remove_cvref_t<Vs>::size...>();
+            return [&]<std::size_t... K>(std::index_sequence<K...>) -> R {
+                return std::forward<F>(visitor)(GetAt<indices[K]>(std::forward<Vs>(variants))...);
+            }(std::index_sequence_for<Vs...>());
+        }
+
+        template <std::size_t... Flat>
+        static constexpr auto Make(std::index_sequence<Flat...>) {
+            return std::array<R (*)(F&&, Vs&&...), sizeof...(Flat)>{&Call<Flat>...};
+        }
+
+        static constexpr auto kTable = Make(std::make_index_sequence<(std::remove_cvref_t<Vs>::size * ... * 1)>());
+    };
+}
+
+// Calls visitor(std::type_identity<T>()) for the type T at position index of TL.
+// Every call must return the same type. Requires index < Length<TL>.
+template <type_lists::TypeList TL, typename F>
+decltype(auto) Dispatch(std::size_t index, F&& visitor) {
+    return detail::Dispatch(index, std::forward<F>(visitor), type_lists::ToTuple<TL>());
+}
+
+// A value of one of the distinct types of TL, the first one by default.
+// Alternatives must be nothrow move constructible, so a Variant always holds a value.
+// Copies, moves and destruction are trivial when they are for every alternative.
+template <type_lists::TypeList TL>
+class Variant {
+    using Info = detail::AlternativesOf<TL>;
+
+    static_assert(Info::size > 0, "Variant: the type list is empty");
+    static_assert(Info::distinct, "Variant: alternatives must be distinct");
+    static_assert(Info::nothrow_movable, "Variant: alternatives must be nothrow move constructible");
+
+    template <typename U>
+    static constexpr bool is_alternative = Info::template count<U> == 1;
+
+public:
+    using IsVariantTag = void;
+    using IndexType = detail::SmallestIndex<Info::size>;
+
+    static constexpr std::size_t size = Info::size;
+
+    template <std::size_t I>
+    using Alternative = typename Info::template At<I>;
+
+    template <typename U>
+    static constexpr std::size_t index_of = Info::template index_of<U>;
+
+    Variant() noexcept(std::is_nothrow_default_constructible_v<Alternative<0>>) {
+        ::new (storage_) Alternative<0>();
+    }
+
+    template <typename U, typename Decayed = std::remove_cvref_t<U>>
+    requires is_alternative<Decayed>
+    Variant(U&& value) noexcept(std::is_nothrow_constructible_v<Decayed, U&&>)
+        : index_(static_cast<IndexType>(index_of<Decayed>)) {
+        ::new (storage_) Decayed(std::forward<U>(value));
+    }
+
+    template <typename U, typename... Args>
+    requires is_alternative<U>
+    explicit Variant(std::in_place_type_t<U>, Args&&... args)
+        : index_(static_cast<IndexType>(index_of<U>)) {
+        ::new (storage_) U(std::forward<Args>(args)...);
+    }
+
+    Variant(const Variant&) requires Info::trivially_copyable = default;
+    Variant(const Variant& other) requires (Info::copyable && !Info::trivially_copyable) : index_(other.index_) {
+        other.VisitType([&]<typename U>(std::type_identity<U>) {
+            ::new (storage_) U(other.template Get<U>());
+        });
+    }
+
+    Variant(Variant&&) requires Info::trivially_copyable = default;
+    Variant(Variant&& other) noexcept requires (!Info::trivially_copyable) : index_(other.index_) {
+        other.VisitType([&]<typename U>(std::type_identity<U>) {
+            ::new (storage_) U(std::move(other.template Get<U>()));
+        });
+    }
+
+    Variant& operator=(const Variant&) requires Info::trivially_copyable = default;
+    Variant& operator=(const Variant& other) requires (Info::copy_assignable && !Info::trivially_copyable) {
+        if (this == &other) return *this;
+        if (index_ == other.index_) {
+            other.VisitType([&]<typename U>(std::type_identity<U>) {
+                Get<U>() = other.template Get<U>();
+            });
+        } else {
+            Variant copy(other);
+            Destroy();
+            MoveFrom(std::move(copy));
+        }
+        return *this;
+    }
+
+    Variant& operator=(Variant&&) requires Info::trivially_copyable = default;
+    Variant& operator=(Variant&& other) noexcept requires (Info::move_assignable && !Info::trivially_copyable) {
+        if (this == &other) return *this;
+        if (index_ == other.index_) {
+            other.VisitType([&]<typename U>(std::type_identity<U>) {
+                Get<U>() = std::move(other.template Get<U>());
+            });
+        } else {
+            Destroy();
+            MoveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    ~Variant() requires Info::trivially_destructible = default;
+    ~Variant() requires (!Info::trivially_destructible) {
+        Destroy();
+    }
+
+    // Observers
+
+    std::size_t Index() const noexcept {
+        return index_;
+    }
+
+    template <typename U>
+    requires is_alternative<U>
+    bool Holds() const noexcept {
+        return index_ == index_of<U>;
+    }
+
+    // Requires Holds<U>()
+    template <typename U>
+    requires is_alternative<U>
+    U& Get() & noexcept {
+        return *std::launder(reinterpret_cast<U*>(storage_));
+    }
+
+    template <typename U>
+    requires is_alternative<U>
+    const U& Get() const& noexcept {
+        return *std::launder(reinterpret_cast<const U*>(storage_));
+    }
+
+    template <typename U>
+    requires is_alternative<U>
+    U&& Get() && noexcept {
+        return std::move(Get<U>());
+    }
+
+    template <typename U>
+    requires is_alternative<U>
+    U* GetIf() noexcept {
+        return Holds<U>() ? &Get<U>() : nullptr;
+    }
+
+    template <typename U>
+    requires is_alternative<U>
+    const U* GetIf() const noexcept {
+        return Holds<U>() ? &Get<U>() : nullptr;
+    }
+
+    // Modifiers
+
+    template <typename U, typename... Args>
+    requires is_alternative<U>
+    U& Emplace(Args&&... args) {
+        U value(std::forward<Args>(args)...);
+        Destroy();
+        ::new (storage_) U(std::move(value));
+        index_ = static_cast<IndexType>(index_of<U>);
+        return Get<U>();
+    }
+
+private:
+    template <typename F>
+    void VisitType(F&& visitor) const {
+        Dispatch<TL>(index_, std::forward<F>(visitor));
+    }
+
+    void Destroy() noexcept {
+        if constexpr (!Info::trivially_destructible) {
+            VisitType([&]<typename U>(std::type_identity<U>) {
+                Get<U>().~U();
+            });
+        }
+    }
+
+    // Requires the held value to be destroyed
+    void MoveFrom(Variant&& other) noexcept {
+        other.VisitType([&]<typename U>(std::type_identity<U>) {
+            ::new (storage_) U(std::move(other.template Get<U>()));
+        });
+        index_ = other.index_;
+    }
+
+    alignas(Info::max_align) std::byte storage_[Info::max_size];
+    IndexType index_ = 0;
+};
+
+// Calls visitor with the held alternative of every variant, through one table of
+// the product of their sizes. Every combination must return the same type.
+template <typename F, typename... Vs>
+requires (sizeof...(Vs) > 0 && (detail::IsVariant<Vs> && ...))
+decltype(auto) Visit(F&& visitor, Vs&&... variants) {
+    using R = decltype(std::forward<F>(visitor)(detail::GetAt<0>(std::forward<Vs>(variants))...));
+    std::size_t flat = 0;
+    ((flat = flat * std::remove_cvref_t<Vs>::size + variants.Index()), ...);
+    return detail::VisitTable<R, F, Vs...>::kTable[flat](std::forward<F>(visitor), std::forward<Vs>(variants)...);
+}
+
+} // namespace type_dispatch
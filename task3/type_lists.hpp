@@ -3,7 +3,9 @@
 #include <concepts>
 
 #include <csignal>
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <type_tuples.hpp>
 
 
@@ -31,41 +33,102 @@ struct Cons {
     using Tail = TL;
 };
 
-// FromTuple
+// Finite lists are walked in blocks that double in size, so walking a list of N types takes
+// O(log N) nested instantiations. Lists are built 16 types per step, folds over a list use fold
+// expressions. Infinite lists are only ever walked as far as the result needs.
+
 namespace detail {
+    template <type_tuples::TypeTuple Lhs, type_tuples::TypeTuple Rhs>
+    struct JoinTuplesImpl;
+
+    template <typename... Lhs, typename... Rhs>
+    struct JoinTuplesImpl<type_tuples::TTuple<Lhs...>, type_tuples::TTuple<Rhs...>> {
+        using Type = type_tuples::TTuple<Lhs..., Rhs...>;
+    };
+
+    template <type_tuples::TypeTuple Lhs, type_tuples::TypeTuple Rhs>
+    using JoinTuples = typename JoinTuplesImpl<Lhs, Rhs>::Type;
+
     template <type_tuples::TypeTuple TT>
-    struct FromTupleImpl;
+    constexpr std::size_t kTupleSize = []<typename... Ts>(type_tuples::TTuple<Ts...>) {
+        return sizeof...(Ts);
+    }(TT{});
+
+    // The first 2^K elements of TL (fewer if it ends earlier) and the list after them
+    template <std::size_t K, TypeList TL>
+    struct Split {
+        using First = Split<K - 1, TL>;
+        using Second = Split<K - 1, typename First::Rest>;
+        using Items = JoinTuples<typename First::Items, typename Second::Items>;
+        using Rest = typename Second::Rest;
+    };
 
-    template <typename Head, typename... Tail>
-    struct FromTupleImpl<type_tuples::TTuple<Head, Tail...>> {
-        using Type = Cons<Head, typename FromTupleImpl<type_tuples::TTuple<Tail...>>::Type>;
+    template <TypeList TL>
+    struct Split<0, TL> {
+        using Items = type_tuples::TTuple<typename TL::Head>;
+        using Rest = typename TL::Tail;
     };
 
-    template <>
-    struct FromTupleImpl<type_tuples::TTuple<>> {
-        using Type = Nil;
+    template <std::size_t K, Empty TL>
+    struct Split<K, TL> {
+        using Items = type_tuples::TTuple<>;
+        using Rest = TL;
+    };
+
+    template <Empty TL>
+    struct Split<0, TL> {
+        using Items = type_tuples::TTuple<>;
+        using Rest = TL;
+    };
+}
+
+// FromTuple
+namespace detail {
+    // Conses the types of TT in front of TL, 16 at a time
+    template <type_tuples::TypeTuple TT, TypeList TL>
+    struct PrependImpl;
+
+    template <TypeList TL>
+    struct PrependImpl<type_tuples::TTuple<>, TL> {
+        using Type = TL;
+    };
+
+    template <typename T, typename... Ts, TypeList TL>
+    struct PrependImpl<type_tuples::TTuple<T, Ts...>, TL> {
+        using Type = Cons<T, typename PrependImpl<type_tuples::TTuple<Ts...>, TL>::Type>;
+    };
+
+    template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10, typename T11, typename T12, typename T13, typename T14, typename T15, typename... Ts, TypeList TL>
+    struct PrependImpl<type_tuples::TTuple<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, Ts...>, TL> {
+        using Type = Cons<T0, Cons<T1, Cons<T2, Cons<T3, Cons<T4, Cons<T5, Cons<T6, Cons<T7, Cons<T8, Cons<T9, Cons<T10, Cons<T11, Cons<T12, Cons<T13, Cons<T14, Cons<T15, typename PrependImpl<type_tuples::TTuple<Ts...>, TL>::Type>>>>>>>>>>>>>>>>;
     };
 }
 
 template <type_tuples::TypeTuple TT>
-using FromTuple = typename detail::FromTupleImpl<TT>::Type;
+using FromTuple = typename detail::PrependImpl<TT, Nil>::Type;
 
 // ToTuple
 namespace detail {
-    template <TypeList TL, typename... Accumulated>
+    // Takes blocks of 1, 2, 4, ... elements until the list ends
+    template <TypeList TL, std::size_t K = 0, typename Accumulated = type_tuples::TTuple<>>
     struct ToTupleImpl {
-        using Type = typename ToTupleImpl<typename TL::Tail, Accumulated..., typename TL::Head>::Type;
+        using Block = Split<K, TL>;
+        using Type = typename ToTupleImpl<typename Block::Rest, K + 1, JoinTuples<Accumulated, typename Block::Items>>::Type;
     };
 
-    template <Empty TL, typename... Accumulated>
-    struct ToTupleImpl<TL, Accumulated...> {
-        using Type = type_tuples::TTuple<Accumulated...>;
+    template <Empty TL, std::size_t K, typename Accumulated>
+    struct ToTupleImpl<TL, K, Accumulated> {
+        using Type = Accumulated;
     };
 }
 
 template <TypeList TL>
 using ToTuple = typename detail::ToTupleImpl<TL>::Type;
 
+// Length
+template <TypeList TL>
+constexpr std::size_t Length = detail::kTupleSize<ToTuple<TL>>;
+
 // Repeat
 template <typename T>
 struct Repeat {
@@ -92,18 +155,35 @@ struct Take<N, TL> : Nil {
 
 // Drop
 namespace detail {
-    template <std::size_t N, TypeList TL>
-    struct DropImpl {
-        using Type = typename DropImpl<N - 1, typename TL::Tail>::Type;
+    // Drops 2^K elements
+    template <std::size_t K, TypeList TL>
+    struct DropPow {
+        using Type = typename DropPow<K - 1, typename DropPow<K - 1, TL>::Type>::Type;
     };
 
     template <TypeList TL>
-    struct DropImpl<0, TL> {
+    struct DropPow<0, TL> {
+        using Type = typename TL::Tail;
+    };
+
+    template <std::size_t K, Empty TL>
+    struct DropPow<K, TL> {
         using Type = TL;
     };
 
-    template <std::size_t N, Empty TL>
-    struct DropImpl<N, TL> {
+    template <Empty TL>
+    struct DropPow<0, TL> {
+        using Type = TL;
+    };
+
+    // Drops N elements one set bit of N at a time
+    template <std::size_t N, TypeList TL, std::size_t K = 0>
+    struct DropImpl {
+        using Type = typename DropImpl<N / 2, std::conditional_t<N % 2 == 1, typename DropPow<K, TL>::Type, TL>, K + 1>::Type;
+    };
+
+    template <TypeList TL, std::size_t K>
+    struct DropImpl<0, TL, K> {
         using Type = TL;
     };
 }
@@ -111,21 +191,73 @@ namespace detail {
 template <std::size_t N, TypeList TL>
 using Drop = typename detail::DropImpl<N, TL>::Type;
 
+// At
+template <std::size_t I, TypeList TL>
+using At = typename Drop<I, TL>::Head;
+
 // Replicate
 namespace detail {
-    template <std::size_t N, typename T>
-    struct ReplicateImpl {
-        using Type = Cons<T, typename ReplicateImpl<N - 1, T>::Type>;
+    template <std::size_t, typename T>
+    using Always = T;
+
+    template <typename T, std::size_t... I>
+    auto ReplicateImpl(std::index_sequence<I...>) -> type_tuples::TTuple<Always<I, T>...>;
+}
+
+template <std::size_t N, typename T>
+using Replicate = FromTuple<decltype(detail::ReplicateImpl<T>(std::make_index_sequence<N>()))>;
+
+// Concat
+namespace detail {
+    template <TypeList L, TypeList R>
+    struct ConcatImpl;
+}
+
+template <TypeList L, TypeList R>
+using Concat = typename detail::ConcatImpl<L, R>::Type;
+
+namespace detail {
+    template <TypeList L, TypeList R>
+    struct ConcatList {
+        using Head = typename L::Head;
+        using Tail = Concat<typename L::Tail, R>;
     };
 
-    template <typename T>
-    struct ReplicateImpl<0, T> {
-        using Type = Nil;
+    template <TypeList L, TypeList R>
+    struct ConcatImpl {
+        using Type = ConcatList<L, R>;
+    };
+
+    template <Empty L, TypeList R>
+    struct ConcatImpl<L, R> {
+        using Type = R;
     };
 }
 
-template <std::size_t N, typename T>
-using Replicate = typename detail::ReplicateImpl<N, T>::Type;
+// Reverse
+namespace detail {
+    // Conses the types of TT in front of TL in reverse order, 16 at a time
+    template <type_tuples::TypeTuple TT, TypeList TL>
+    struct ReversePrependImpl;
+
+    template <TypeList TL>
+    struct ReversePrependImpl<type_tuples::TTuple<>, TL> {
+        using Type = TL;
+    };
+
+    template <typename T, typename... Ts, TypeList TL>
+    struct ReversePrependImpl<type_tuples::TTuple<T, Ts...>, TL> {
+        using Type = typename ReversePrependImpl<type_tuples::TTuple<Ts...>, Cons<T, TL>>::Type;
+    };
+
+    template <typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10, typename T11, typename T12, typename T13, typename T14, typename T15, typename... Ts, TypeList TL>
+    struct ReversePrependImpl<type_tuples::TTuple<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, Ts...>, TL> {
+        using Type = typename ReversePrependImpl<type_tuples::TTuple<Ts...>, Cons<T15, Cons<T14, Cons<T13, Cons<T12, Cons<T11, Cons<T10, Cons<T9, Cons<T8, Cons<T7, Cons<T6, Cons<T5, Cons<T4, Cons<T3, Cons<T2, Cons<T1, Cons<T0, TL>>>>>>>>>>>>>>>>>::Type;
+    };
+}
+
+template <TypeList TL>
+using Reverse = typename detail::ReversePrependImpl<ToTuple<TL>, Nil>::Type;
 
 // Map
 template <template <typename> class F, TypeList TL>
@@ -141,48 +273,74 @@ struct Map<F, TL> : Nil {
 
 // Filter
 namespace detail {
+    inline constexpr std::size_t kMaxFilterBlockLog = 6;
+
+    // Position of the first element of TT that satisfies P, the size of TT if there is none
+    template <template <typename> class P, typename... Ts>
+    constexpr std::size_t FirstAccepted(type_tuples::TTuple<Ts...>) {
+        constexpr bool accepted[] = {static_cast<bool>(P<Ts>::Value)..., true};
+        std::size_t index = 0;
+        while (!accepted[index]) {
+            ++index;
+        }
+        return index;
+    }
+
+    template <template <typename> class P, TypeList TL, std::size_t K = 0>
+    struct SkipRejected;
+
+    template <bool found>
+    struct SkipRejectedStep {
+        template <template <typename> class P, TypeList TL, typename Block, std::size_t K, std::size_t index>
+        using Type = Drop<index, TL>;
+    };
 
-    template <template <typename> class P, TypeList TL, bool = false>
-    struct FilterImpl;
+    template <>
+    struct SkipRejectedStep<false> {
+        template <template <typename> class P, TypeList TL, typename Block, std::size_t K, std::size_t index>
+        using Type = typename SkipRejected<P, typename Block::Rest, (K < kMaxFilterBlockLog ? K + 1 : K)>::Type;
+    };
 
-    template <template <typename> class P, TypeList TL>
-    struct FilterDispatcherImpl;
+    // First position of TL whose head satisfies P, an empty list if there is none.
+    // Elements are tested in blocks of 1, 2, 4, ... 2^kMaxFilterBlockLog, so a long run of
+    // rejected elements costs few nested instantiations and at most one block of lookahead.
+    template <template <typename> class P, TypeList TL, std::size_t K>
+    struct SkipRejected {
+        using Block = Split<K, TL>;
+        static constexpr std::size_t index = FirstAccepted<P>(typename Block::Items{});
 
-    template <template <typename> class P, TypeSequence TL>
-    struct FilterDispatcherImpl<P, TL> {
-        using Type = FilterImpl<P, TL, P<typename TL::Head>::Value>;
+        using Type = typename SkipRejectedStep<index < kTupleSize<typename Block::Items>>::template Type<P, TL, Block, K, index>;
     };
 
-    template <template <typename> class P, Empty TL>
-    struct FilterDispatcherImpl<P, TL> {
-        using Type = FilterImpl<P, TL>;
+    template <template <typename> class P, Empty TL, std::size_t K>
+    struct SkipRejected<P, TL, K> {
+        using Type = TL;
     };
 
     template <template <typename> class P, TypeList TL>
-    using FilterDispatcher = typename FilterDispatcherImpl<P, TL>::Type;
-
-    template <template <typename> class P, Empty TL>
-    struct FilterImpl<P, TL> : Nil {
-        // using Head = Nil;  // for compatibility
-        // using Tail = Nil;  // for compatibility
-    };
+    struct FilterImpl;
 
-    template <template <typename> class P, TypeSequence TL>
-    struct FilterImpl<P, TL, true> {
+    template <template <typename> class P, TypeList TL>
+    struct FilterNode {
         using Head = typename TL::Head;
-        using Tail = FilterDispatcher<P, typename TL::Tail>;
+        using Tail = FilterImpl<P, typename TL::Tail>;
     };
 
-    template <template <typename> class P, TypeSequence TL>
-    struct FilterImpl<P, TL, false> : FilterDispatcher<P, typename TL::Tail> {
-        using typename FilterDispatcher<P, typename TL::Tail>::Head;
-        using typename FilterDispatcher<P, typename TL::Tail>::Tail;
+    template <template <typename> class P, Empty TL>
+    struct FilterNode<P, TL> : Nil {
+
     };
 
+    // The search for the next accepted element runs only when the node is instantiated,
+    // so naming the tail of an infinite filtered list is free
+    template <template <typename> class P, TypeList TL>
+    struct FilterImpl : FilterNode<P, typename SkipRejected<P, TL>::Type> {
+
+    };
 }
 
 template <template <typename> class P, TypeList TL>
-using Filter = detail::FilterDispatcher<P, TL>;
+using Filter = detail::FilterImpl<P, TL>;
 
 // Iterate
 namespace detail {
@@ -247,37 +405,40 @@ struct Tails<TL> {
 };
 
 // Scanl
-namespace detail {
-    template <template <typename, typename> class OP, typename T, TypeList TL>
-    struct ScanlImpl {
-        using Type = Cons<T, typename ScanlImpl<OP, OP<T, typename TL::Head>, typename TL::Tail>::Type>;
-    };
-
-    template <template <typename, typename> class OP, typename T, Empty TL>
-    struct ScanlImpl<OP, T, TL> {
-        using Type = Cons<T, Nil>;
-    };
-
-}
-
 template <template <typename, typename> class OP, typename T, TypeList TL>
-using Scanl = typename detail::ScanlImpl<OP, T, TL>::Type;
+struct Scanl {
+    using Head = T;
+    using Tail = Scanl<OP, OP<T, typename TL::Head>, typename TL::Tail>;
+};
+
+template <template <typename, typename> class OP, typename T, Empty TL>
+struct Scanl<OP, T, TL> {
+    using Head = T;
+    using Tail = Nil;
+};
 
 // Foldl
 namespace detail {
-    template <template <typename, typename> class OP, typename T, TypeList TL>
-    struct FoldlImpl {
-        using Type = OP<typename FoldlImpl<OP, T, typename TL::Tail>::Type, typename TL::Head>;
+    template <template <typename, typename> class OP, typename T>
+    struct FoldStep {
+        using Type = T;
     };
 
-    template <template <typename, typename> class OP, typename T, Empty TL>
-    struct FoldlImpl<OP, T, TL> {
-        using Type = T;
+    template <template <typename, typename> class OP, typename T, typename Accumulated>
+    FoldStep<OP, OP<Accumulated, T>> operator|(FoldStep<OP, T>, FoldStep<OP, Accumulated>);
+
+    template <template <typename, typename> class OP, typename T, type_tuples::TypeTuple TT>
+    struct FoldlImpl;
+
+    // Right fold OP<OP<OP<T, Tn>, ...>, T1>: the elements are applied from the back of the list
+    template <template <typename, typename> class OP, typename T, typename... Ts>
+    struct FoldlImpl<OP, T, type_tuples::TTuple<Ts...>> {
+        using Type = typename decltype((FoldStep<OP, Ts>{} | ... | FoldStep<OP, T>{}))::Type;
     };
 }
 
 template <template <typename, typename> class OP, typename T, TypeList TL>
-using Foldl = typename detail::FoldlImpl<OP, T, TL>::Type;
+using Foldl = typename detail::FoldlImpl<OP, T, ToTuple<TL>>::Type;
 
 // Zip2
 template <TypeList L, TypeList R>
@@ -296,11 +457,26 @@ template <Empty L, Empty R>
 struct Zip2<L, R> : Nil {};
 
 // Zip
-// TODO for finite lists
+// Ends with the shortest list
 template <TypeList... TL>
-struct Zip {
-    using Head = type_tuples::TTuple<typename TL::Head...>;
-    using Tail = Zip<typename TL::Tail...>;
+struct Zip;
+
+namespace detail {
+    template <bool end, TypeList... TL>
+    struct ZipImpl {
+        using Head = type_tuples::TTuple<typename TL::Head...>;
+        using Tail = Zip<typename TL::Tail...>;
+    };
+
+    template <TypeList... TL>
+    struct ZipImpl<true, TL...> : Nil {
+
+    };
+}
+
+template <TypeList... TL>
+struct Zip : detail::ZipImpl<sizeof...(TL) == 0 || (Empty<TL> || ...), TL...> {
+
 };
 
 } // namespace type_lists
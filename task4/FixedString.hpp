@@ -7,6 +7,9 @@
 
 template<size_t max_length>
 struct FixedString {
+  constexpr FixedString() : storage({}), length(0) {
+  }
+
   constexpr FixedString(const char* string, size_t length) : storage({}), length(length) {
     std::copy(string, string + length, storage.begin());
     // std::fill(storage.begin() + length, storage.end(), '\0');
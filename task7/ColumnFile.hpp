@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <MappedFile.hpp>
+#include <Span.hpp>
+#include <reflect.hpp>
+
+// Columnar files of aggregates that Describe<T> understands.
+//
+//   ColumnFileWriter<Trade> writer("trades.col", 1 << 24);   // room for 16M rows
+//   writer.Append(trade);                                     // published in batches
+//
+//   ColumnFileReader<Trade> reader("trades.col");
+//   Span<const double> prices = reader.Column<2>();            // no parsing, no copy
+//
+// Layout:
+//   - a header page: magic, version, field count, row capacity, committed row count and
+//     for every field its column offset, size and alignment
+//   - one column per field, capacity * sizeof(field) bytes, each starting on a page boundary
+// The file is sized for the full capacity when it is created; columns are written in place,
+// so pages of rows that were never appended stay unallocated on file systems with sparse files.
+// The row count is published with a release store after a batch of rows has been written,
+// so a reader may open the file and scan committed rows while the writer keeps appending.
+// Fields must be trivially copyable.
+
+namespace detail::column_file {
+
+    inline constexpr char kMagic[8] = {'D', 'E', 'S', 'C', 'C', 'O', 'L', '1'};
+    inline constexpr std::uint32_t kVersion = 1;
+    inline constexpr std::size_t kPageSize = 4096;
+    inline constexpr std::size_t kMaxFields = 64;
+
+    struct FieldEntry {
+        std::uint64_t offset;
+        std::uint32_t size;
+        std::uint32_t alignment;
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t num_fields;
+        std::uint64_t capacity;
+        std::uint64_t rows;  // committed rows, accessed atomically
+        FieldEntry fields[kMaxFields];
+    };
+
+    static_assert(sizeof(Header) <= kPageSize);
+
+    inline constexpr std::size_t RoundUp(std::size_t size) noexcept {
+        return (size + kPageSize - 1) / kPageSize * kPageSize;
+    }
+
+    template <class T>
+    struct Schema {
+        using Reflection = Describe<T>;
+        static constexpr std::size_t num_fields = Reflection::num_fields;
+
+        template <std::size_t I>
+        using FieldType = typename Reflection::template Field<I>::Type;
+
+        static_assert(num_fields <= kMaxFields, "ColumnFile: too many fields");
+        static_assert([]<std::size_t... I>(std::index_sequence<I...>) {
+            return (std::is_trivially_copyable_v<FieldType<I>> && ...);
+        }(std::make_index_sequence<num_fields>()), "ColumnFile: fields must be trivially copyable");
+
+        // Header of an empty file with room for `capacity` rows
+        static Header Make(std::uint64_t capacity) noexcept {
+            Header header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kVersion;
+            header.num_fields = num_fields;
+            header.capacity = capacity;
+            std::uint64_t offset = kPageSize;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((header.fields[I] = {offset, sizeof(FieldType<I>), alignof(FieldType<I>)},
+                  offset += RoundUp(capacity * sizeof(FieldType<I>))), ...);
+            }(std::make_index_sequence<num_fields>());
+            return header;
+        }
+
+        static std::uint64_t FileSize(std::uint64_t capacity) noexcept {
+            std::uint64_t size = kPageSize;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((size += RoundUp(capacity * sizeof(FieldType<I>))), ...);
+            }(std::make_index_sequence<num_fields>());
+            return size;
+        }
+
+        // Throws if the header does not describe a file of T that fits into file_size bytes
+        static void Check(const Header& header, std::size_t file_size) {
+            if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+                throw std::runtime_error("ColumnFile: not a column file");
+            }
+            if (header.num_fields != num_fields) {
+                throw std::runtime_error("ColumnFile: field count does not match the record type");
+            }
+            Header expected = Make(header.capacity);
+            for (std::size_t i = 0; i < num_fields; ++i) {
+                const FieldEntry& lhs = header.fields[i];
+                const FieldEntry& rhs = expected.fields[i];
+                if (lhs.offset != rhs.offset || lhs.size != rhs.size || lhs.alignment != rhs.alignment) {
+                    throw std::runtime_error("ColumnFile: field layout does not match the record type");
+                }
+            }
+            if (FileSize(header.capacity) > file_size) {
+                throw std::runtime_error("ColumnFile: file is truncated");
+            }
+        }
+    };
+
+}  // namespace detail::column_file
+
+
+// Creates a column file and appends rows to it. Not thread-safe, one writer per file.
+template <class T>
+class ColumnFileWriter {
+    using Schema = detail::column_file::Schema<T>;
+    using Header = detail::column_file::Header;
+
+public:
+    // Rows become visible to readers every `batch` appends and on Flush
+    ColumnFileWriter(const std::string& path, std::size_t capacity, std::size_t batch = 4096)
+        : capacity_(capacity), batch_(std::max<std::size_t>(batch, 1)) {
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        size_ = Schema::FileSize(capacity);
+        if (::ftruncate(fd, static_cast<off_t>(size_)) == -1) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "ftruncate " + path);
+        }
+        void* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap " + path);
+        }
+        data_ = static_cast<std::byte*>(data);
+
+        Header header = Schema::Make(capacity);
+        std::memcpy(data_, &header, sizeof(header));
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((columns_[I] = data_ + header.fields[I].offset), ...);
+        }(std::make_index_sequence<Schema::num_fields>());
+    }
+
+    ColumnFileWriter(const ColumnFileWriter&) = delete;
+    ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+
+    ColumnFileWriter(ColumnFileWriter&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          columns_(other.columns_),
+          capacity_(other.capacity_),
+          batch_(other.batch_),
+          rows_(std::exchange(other.rows_, 0)),
+          committed_(std::exchange(other.committed_, 0)) {
+
+    }
+
+    ~ColumnFileWriter() {
+        if (data_ != nullptr) {
+            Flush();
+            ::munmap(data_, size_);
+        }
+    }
+
+    // Observers
+
+    std::size_t Rows() const noexcept {
+        return rows_;
+    }
+
+    std::size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    // Modifiers
+
+    // Throws std::length_error once the capacity is used up
+    void Append(const T& value) {
+        if (rows_ == capacity_) {
+            throw std::length_error("ColumnFile: capacity exceeded");
+        }
+        Store(rows_, value);
+        if (++rows_ - committed_ >= batch_) {
+            Flush();
+        }
+    }
+
+    // Rows are scattered column by column, so each column is written sequentially
+    void Append(Span<const T> values) {
+        if (values.Size() > capacity_ - rows_) {
+            throw std::length_error("ColumnFile: capacity exceeded");
+        }
+        ForEachColumn([&]<std::size_t I>() {
+            auto* column = Column<I>() + rows_;
+            for (std::size_t row = 0; row < values.Size(); ++row) {
+                column[row] = Describe<T>::template Get<I>(values[row]);
+            }
+        });
+        rows_ += values.Size();
+        if (rows_ - committed_ >= batch_) {
+            Flush();
+        }
+    }
+
+    // Publishes all appended rows to readers
+    void Flush() noexcept {
+        if (committed_ == rows_) return;
+        committed_ = rows_;
+        __atomic_store_n(&HeaderRows(), static_cast<std::uint64_t>(committed_), __ATOMIC_RELEASE);
+    }
+
+    // Flushes and writes the mapping back to disk
+    void Sync() {
+        Flush();
+        if (::msync(data_, size_, MS_SYNC) == -1) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+private:
+    template <class F>
+    static void ForEachColumn(F&& f) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f.template operator()<I>(), ...);
+        }(std::make_index_sequence<Schema::num_fields>());
+    }
+
+    template <std::size_t I>
+    typename Schema::template FieldType<I>* Column() const noexcept {
+        return reinterpret_cast<typename Schema::template FieldType<I>*>(columns_[I]);
+    }
+
+    void Store(std::size_t row, const T& value) noexcept {
+        ForEachColumn([&]<std::size_t I>() {
+            Column<I>()[row] = Describe<T>::template Get<I>(value);
+        });
+    }
+
+    std::uint64_t& HeaderRows() const noexcept {
+        return reinterpret_cast<Header*>(data_)->rows;
+    }
+
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::array<std::byte*, Schema::num_fields> columns_{};
+    std::size_t capacity_;
+    std::size_t batch_;
+    std::size_t rows_ = 0;
+    std::size_t committed_ = 0;
+};
+
+
+// Maps a column file and hands out typed column views over the mapping
+template <class T>
+class ColumnFileReader {
+    using Schema = detail::column_file::Schema<T>;
+    using Header = detail::column_file::Header;
+
+public:
+    template <std::size_t I>
+    using FieldType = typename Schema::template FieldType<I>;
+
+    explicit ColumnFileReader(const std::string& path, MappedFile::Access access = MappedFile::Access::kSequential)
+        : file_(path, MappedFile::Options{.access = access}) {
+        if (file_.Size() < sizeof(Header)) {
+            throw std::runtime_error("ColumnFile: file is truncated");
+        }
+        Schema::Check(GetHeader(), file_.Size());
+    }
+
+    // Rows committed by the writer so far, grows while the file is being appended to
+    std::size_t Rows() const noexcept {
+        return static_cast<std::size_t>(__atomic_load_n(&GetHeader().rows, __ATOMIC_ACQUIRE));
+    }
+
+    std::size_t Capacity() const noexcept {
+        return static_cast<std::size_t>(GetHeader().capacity);
+    }
+
+    // Field I of every committed row
+    template <std::size_t I>
+    Span<const FieldType<I>> Column() const {
+        return file_.View<FieldType<I>>(GetHeader().fields[I].offset, Rows());
+    }
+
+    // Row `index` assembled from the columns
+    T Row(std::size_t index) const {
+        T value{};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((Describe<T>::template Get<I>(value) = Column<I>()[index]), ...);
+        }(std::make_index_sequence<Schema::num_fields>());
+        return value;
+    }
+
+private:
+    const Header& GetHeader() const noexcept {
+        return *reinterpret_cast<const Header*>(file_.Data());
+    }
+
+    MappedFile file_;
+};
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <EnumeratorTraits.hpp>
+#include <FixedString.hpp>
+#include <SoAVector.hpp>
+#include <Span.hpp>
+#include <SpanKernels.hpp>
+#include <reflect.hpp>
+
+// Streaming CSV/TSV loader into SoAVector, with field parsers generated from Describe<T>.
+//
+//   struct Tick { std::uint64_t time; FixedString<8> symbol; Side side; double price; };
+//
+//   SoAVector<Tick> ticks;
+//   CsvLoader<Tick> loader(ticks, {.delimiter = ',', .header = true});
+//   for (Span<const char> block : blocks) loader.Feed(block);   // blocks may split lines anywhere
+//   loader.Finish();
+//
+// Every line holds one value per field of T, in declaration order. Supported field types:
+// integers and floats (std::from_chars), bool (0/1/true/false), char, FixedString<N>,
+// std::string and enums (enumerator names through EnumeratorTraits, or any numeric value of the
+// underlying type, enumerator or not).
+// Quoting is not supported: values may not contain the delimiter or a newline.
+// A trailing '\r' is dropped and empty lines are skipped.
+//
+// Blocks are scanned 64 bytes at a time for delimiters and newlines (SSE2 compares and a
+// bitmask walk), each value is parsed straight from the block into a reused row, and the row is
+// appended to the columns. Only the tail of a block that ends mid-line is copied.
+// Malformed input throws std::runtime_error naming the line and the field, both counted from 1.
+
+namespace csv {
+
+    struct Options {
+        char delimiter = ',';
+        bool header = false;  // the first line holds column names and is skipped
+    };
+
+}  // namespace csv
+
+namespace detail::csv {
+
+    inline constexpr std::size_t kScanBytes = 64;
+
+    // Bit i is set if data[i] is the delimiter or a newline
+    inline std::uint64_t SeparatorMask(const char* data, char delimiter) noexcept {
+        using Bytes = detail::simd::Vec<char, 16>;
+        Bytes delimiters, newlines, bytes;
+        detail::simd::Splat<char, 16>(delimiters, delimiter);
+        detail::simd::Splat<char, 16>(newlines, '\n');
+        std::uint64_t mask = 0;
+        for (std::size_t chunk = 0; chunk < kScanBytes / 16; ++chunk) {
+            detail::simd::Load<char, 16, 1>(bytes, data + chunk * 16);
+            auto hits = (bytes == delimiters) | (bytes == newlines);
+#ifdef __SSE2__
+            auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(reinterpret_cast<__m128i>(hits)));
+#else
+            std::uint32_t bits = 0;
+            for (std::size_t i = 0; i < 16; ++i) {
+                bits |= static_cast<std::uint32_t>(hits[i] != 0) << i;
+            }
+#endif
+            mask |= static_cast<std::uint64_t>(bits) << (chunk * 16);
+        }
+        return mask;
+    }
+
+    template <class U>
+    struct IsFixedString : std::false_type {};
+
+    template <std::size_t N>
+    struct IsFixedString<FixedString<N>> : std::true_type {};
+
+    constexpr bool IsIdentifier(std::string_view name) noexcept {
+        if (name.empty() || (name[0] >= '0' && name[0] <= '9')) return false;
+        for (char c : name) {
+            if (!(c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Names and values of the enumerators of U. EnumeratorTraits also reports values that name
+    // no enumerator on compilers whose signatures it does not parse; their "names" are not
+    // identifiers and are dropped, so a lookup scans real enumerators only.
+    template <class U>
+    struct Enumerators {
+        using Traits = EnumeratorTraits<U>;
+
+        static constexpr std::size_t size = [] {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < Traits::size(); ++i) {
+                count += IsIdentifier(Traits::nameAt(i));
+            }
+            return count;
+        }();
+
+        static constexpr auto table = [] {
+            std::array<std::pair<std::string_view, U>, size> result{};
+            std::size_t index = 0;
+            for (std::size_t i = 0; i < Traits::size(); ++i) {
+                if (IsIdentifier(Traits::nameAt(i))) {
+                    result[index++] = {Traits::nameAt(i), Traits::at(i)};
+                }
+            }
+            return result;
+        }();
+    };
+
+    template <class U>
+    bool ParseNumber(std::string_view text, U& value) noexcept {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    // Parses text into value, false if text is not a valid value of U
+    template <class U>
+    bool ParseValue(std::string_view text, U& value) {
+        if constexpr (std::is_same_v<U, bool>) {
+            if (text == "1" || text == "true") {
+                value = true;
+            } else if (text == "0" || text == "false") {
+                value = false;
+            } else {
+                return false;
+            }
+            return true;
+        } else if constexpr (std::is_same_v<U, char>) {
+            if (text.size() != 1) return false;
+            value = text[0];
+            return true;
+        } else if constexpr (std::is_arithmetic_v<U>) {
+            return ParseNumber(text, value);
+        } else if constexpr (std::is_enum_v<U>) {
+            for (const auto& [name, enumerator] : Enumerators<U>::table) {
+                if (name == text) {
+                    value = enumerator;
+                    return true;
+                }
+            }
+            std::underlying_type_t<U> raw;
+            if (!ParseNumber(text, raw)) return false;
+            value = static_cast<U>(raw);
+            return true;
+        } else if constexpr (IsFixedString<U>::value) {
+            if (text.size() > value.storage.size()) return false;
+            value = U(text.data(), text.size());
+            return true;
+        } else if constexpr (std::is_same_v<U, std::string>) {
+            value.assign(text);
+            return true;
+        } else {
+            static_assert(!sizeof(U), "csv: unsupported field type");
+        }
+    }
+
+    template <class T, std::size_t I>
+    bool ParseField(std::string_view text, T& row) {
+        return ParseValue(text, Describe<T>::template Get<I>(row));
+    }
+
+    template <class T>
+    using FieldParser = bool (*)(std::string_view, T&);
+
+    // Parser of field I at index I, so a runtime field index picks its parser with one load
+    template <class T>
+    inline constexpr auto kParsers = []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<FieldParser<T>, sizeof...(I)>{&ParseField<T, I>...};
+    }(std::make_index_sequence<Describe<T>::num_fields>());
+
+}  // namespace detail::csv
+
+
+template <class T>
+class CsvLoader {
+    static constexpr std::size_t num_fields = Describe<T>::num_fields;
+    static_assert(num_fields > 0, "csv: the record type has no fields");
+
+public:
+    explicit CsvLoader(SoAVector<T>& out, csv::Options options = {})
+        : out_(&out), options_(options), skip_line_(options.header) {
+
+    }
+
+    // Parses all complete lines of text, keeps an unfinished last line for the next call
+    void Feed(Span<const char> text) {
+        const char* data = text.Data();
+        std::size_t size = text.Size();
+        if (!pending_.empty()) {
+            const void* newline = size == 0 ? nullptr : std::memchr(data, '\n', size);
+            if (newline == nullptr) {
+                pending_.append(data, size);
+                return;
+            }
+            std::size_t head = static_cast<std::size_t>(static_cast<const char*>(newline) - data) + 1;
+            pending_.append(data, head);
+            ParseLines(pending_.data(), pending_.size());
+            pending_.clear();
+            data += head;
+            size -= head;
+        }
+        std::size_t consumed = ParseLines(data, size);
+        pending_.assign(data + consumed, size - consumed);
+    }
+
+    // Parses a last line that has no trailing newline
+    void Finish() {
+        if (pending_.empty()) return;
+        pending_.push_back('\n');
+        ParseLines(pending_.data(), pending_.size());
+        pending_.clear();
+    }
+
+    // Reads the stream to its end in blocks of block_size bytes, then calls Finish
+    void Load(std::istream& input, std::size_t block_size = std::size_t{1} << 20) {
+        std::vector<char> block(block_size);
+        while (input) {
+            input.read(block.data(), static_cast<std::streamsize>(block.size()));
+            std::size_t read = static_cast<std::size_t>(input.gcount());
+            if (read == 0) break;
+            Feed(Span<const char>(block.data(), read));
+        }
+        Finish();
+    }
+
+    // Lines seen so far, header and empty lines included
+    std::size_t Lines() const noexcept {
+        return lines_;
+    }
+
+private:
+    // Parses the complete lines at the front of data, returns the number of bytes they take
+    std::size_t ParseLines(const char* data, std::size_t size) {
+        const char delimiter = options_.delimiter;
+        std::size_t line_start = 0;
+        std::size_t field_start = 0;
+        std::size_t field = 0;
+
+        auto separator = [&](std::size_t position) {
+            if (data[position] != '\n') {
+                if (skip_line_) return;
+                // field + 1 is the first value past the end of the record
+                if (field + 1 >= num_fields) Fail(field + 1, "too many values");
+                ParseValue(field++, std::string_view(data + field_start, position - field_start));
+                field_start = position + 1;
+                return;
+            }
+            std::string_view last(data + field_start, position - field_start);
+            if (!last.empty() && last.back() == '\r') {
+                last.remove_suffix(1);
+            }
+            if (skip_line_) {
+                skip_line_ = false;
+            } else if (field != 0 || !last.empty()) {
+                // field + 1 is the first missing value
+                if (field + 1 != num_fields) Fail(field + 1, "too few values");
+                ParseValue(field, last);
+                out_->PushBack(row_);
+            }
+            ++lines_;
+            line_start = field_start = position + 1;
+            field = 0;
+        };
+
+        std::size_t offset = 0;
+        for (; offset + detail::csv::kScanBytes <= size; offset += detail::csv::kScanBytes) {
+            for (std::uint64_t mask = detail::csv::SeparatorMask(data + offset, delimiter); mask != 0; mask &= mask - 1) {
+                separator(offset + static_cast<std::size_t>(__builtin_ctzll(mask)));
+            }
+        }
+        for (; offset < size; ++offset) {
+            if (data[offset] == delimiter || data[offset] == '\n') {
+                separator(offset);
+            }
+        }
+        return line_start;
+    }
+
+    void ParseValue(std::size_t field, std::string_view text) {
+        if (!detail::csv::kParsers<T>[field](text, row_)) {
+            Fail(field, "malformed value '" + std::string(text) + "'");
+        }
+    }
+
+    // field is the 0-based index of the offending value, reported from 1 like the line
+    [[noreturn]] void Fail(std::size_t field, const std::string& what) const {
+        throw std::runtime_error("csv: line " + std::to_string(lines_ + 1) + ", field " + std::to_string(field + 1) + ": " + what);
+    }
+
+    SoAVector<T>* out_;
+    csv::Options options_;
+    bool skip_line_;
+    std::size_t lines_ = 0;
+    T row_{};
+    std::string pending_;
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <Serialize.hpp>
+#include <Span.hpp>
+#include <reflect.hpp>
+
+// Field-level deltas between two values of an aggregate, generated from Describe<T>.
+//
+//   std::size_t size = delta::Diff(previous, current, buffer);   // previous -> current
+//   delta::Apply(replica, buffer.First(size));                     // replica == current afterwards
+//
+// A patch is a bitmask of the changed fields, (num_fields + 7) / 8 bytes with field I in bit I % 8
+// of byte I / 8, followed by the new values of the changed fields in declaration order:
+//   - nested aggregates as a patch of their own, so a change deep inside sends only that field
+//   - everything else as by serialization::Encode, honouring the serialization annotations;
+//     serialization::Skip fields are never part of a patch
+// Fields that are trivially copyable are compared by their bytes without branches,
+// the payload pass then only visits fields whose bit is set.
+// Diff throws std::length_error if out is too small, Apply throws std::out_of_range on malformed patches.
+
+namespace detail::delta {
+
+    namespace serialization = ::detail::serialization;
+
+    template <class T>
+    inline constexpr std::size_t kMaskBytes = (Describe<T>::num_fields + 7) / 8;
+
+    template <class T, std::size_t I>
+    using FieldOf = typename Describe<T>::template Field<I>;
+
+    template <class T, std::size_t I>
+    constexpr bool is_nested = serialization::Described<typename FieldOf<T, I>::Type> && !serialization::is_skipped<FieldOf<T, I>>;
+
+    template <class T, std::size_t I>
+    constexpr bool is_bytes = serialization::Bytes<typename FieldOf<T, I>::Type> && !serialization::is_skipped<FieldOf<T, I>>;
+
+    template <class F, std::size_t... I>
+    void Unroll(F&& f, std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }
+
+    // Bits of the trivially copyable fields that differ, one memcmp per field and no branches
+    template <class T>
+    std::uint64_t BytesMask(const T& lhs, const T& rhs) noexcept {
+        using Reflection = Describe<T>;
+        std::uint64_t mask = 0;
+        Unroll([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (is_bytes<T, I>) {
+                using Type = typename FieldOf<T, I>::Type;
+                bool changed = std::memcmp(&Reflection::template Get<I>(lhs), &Reflection::template Get<I>(rhs), sizeof(Type)) != 0;
+                mask |= static_cast<std::uint64_t>(changed) << I;
+            }
+        }, std::make_index_sequence<Reflection::num_fields>());
+        return mask;
+    }
+
+    // Writes the patch turning lhs into rhs, returns its mask
+    template <class T>
+    std::uint64_t DiffFields(serialization::Writer& writer, const T& lhs, const T& rhs) {
+        using Reflection = Describe<T>;
+        static_assert(Reflection::num_fields <= 64, "delta: at most 64 fields per aggregate");
+
+        std::byte* mask_bytes = writer.Reserve(kMaskBytes<T>);
+        std::uint64_t mask = BytesMask(lhs, rhs);
+        Unroll([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            using Field = FieldOf<T, I>;
+            const auto& from = Reflection::template Get<I>(lhs);
+            const auto& to = Reflection::template Get<I>(rhs);
+            if constexpr (is_bytes<T, I>) {
+                if (mask >> I & 1) {
+                    serialization::EncodeField<Field>(writer, to);
+                }
+            } else if constexpr (is_nested<T, I>) {
+                std::size_t position = writer.Written();
+                if (DiffFields(writer, from, to) != 0) {
+                    mask |= std::uint64_t{1} << I;
+                } else {
+                    writer.Rewind(position);
+                }
+            } else if constexpr (!serialization::is_skipped<Field>) {
+                if (!(from == to)) {
+                    mask |= std::uint64_t{1} << I;
+                    serialization::EncodeField<Field>(writer, to);
+                }
+            }
+        }, std::make_index_sequence<Reflection::num_fields>());
+
+        for (std::size_t i = 0; i < kMaskBytes<T>; ++i) {
+            mask_bytes[i] = static_cast<std::byte>(mask >> (i * 8));
+        }
+        return mask;
+    }
+
+    template <class T>
+    void ApplyFields(serialization::Reader& reader, T& value) {
+        using Reflection = Describe<T>;
+
+        std::array<std::byte, kMaskBytes<T>> mask_bytes;
+        reader.Read(mask_bytes.data(), mask_bytes.size());
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < kMaskBytes<T>; ++i) {
+            mask |= static_cast<std::uint64_t>(mask_bytes[i]) << (i * 8);
+        }
+
+        std::uint64_t known = 0;
+        Unroll([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (!serialization::is_skipped<FieldOf<T, I>>) {
+                known |= std::uint64_t{1} << I;
+            }
+        }, std::make_index_sequence<Reflection::num_fields>());
+        if ((mask & ~known) != 0) {
+            throw std::out_of_range("delta: patch names an unknown field");
+        }
+
+        Unroll([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (!serialization::is_skipped<FieldOf<T, I>>) {
+                if ((mask >> I & 1) == 0) return;
+                if constexpr (is_nested<T, I>) {
+                    ApplyFields(reader, Reflection::template Get<I>(value));
+                } else {
+                    serialization::DecodeField<FieldOf<T, I>>(reader, Reflection::template Get<I>(value));
+                }
+            }
+        }, std::make_index_sequence<Reflection::num_fields>());
+    }
+
+}  // namespace detail::delta
+
+
+namespace delta {
+
+    // Writes the patch that turns from into to, returns the number of bytes written.
+    // Equal values give a patch whose mask bytes are all zero.
+    template <class T>
+    requires ::detail::serialization::Described<T>
+    std::size_t Diff(const T& from, const T& to, Span<std::byte> out) {
+        ::detail::serialization::Writer writer(out);
+        ::detail::delta::DiffFields(writer, from, to);
+        return writer.Written();
+    }
+
+    // Applies the patch at the front of patch to value, returns the number of bytes consumed
+    template <class T>
+    requires ::detail::serialization::Described<T>
+    std::size_t Apply(T& value, Span<const std::byte> patch) {
+        ::detail::serialization::Reader reader(patch);
+        ::detail::delta::ApplyFields(reader, value);
+        return reader.Consumed();
+    }
+
+    // Whether a patch produced by Diff changes anything
+    template <class T>
+    requires ::detail::serialization::Described<T>
+    bool Changes(Span<const std::byte> patch) noexcept {
+        for (std::size_t i = 0; i < ::detail::delta::kMaskBytes<T> && i < patch.Size(); ++i) {
+            if (patch[i] != std::byte{0}) return true;
+        }
+        return false;
+    }
+
+}  // namespace delta
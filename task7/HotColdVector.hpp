@@ -0,0 +1,426 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <reflect.hpp>
+
+// Row container that splits an aggregate into a hot and a cold part.
+//
+//   struct Account {
+//       Annotate<hot_cold::Hot> _1;
+//       std::uint64_t id;
+//       Annotate<hot_cold::Hot> _2;
+//       double balance;
+//       std::string owner;
+//       std::string address;
+//   };
+//
+//   HotColdVector<Account> accounts;
+//   for (std::size_t i = 0; i < accounts.Size(); ++i) total += accounts[i].Get<1>();   // touches hot rows only
+//
+// Hot fields of all rows are stored densely in one array, cold fields in a second array with the
+// same row index, so a scan over hot fields does not pull cold bytes into the cache.
+// Annotations apply to the field that follows them:
+//   - hot_cold::Hot    the field is hot; once any field is marked Hot, unmarked fields are cold
+//   - hot_cold::Cold   the field is cold; without Hot marks, unmarked fields are hot
+// Inside each part fields are ordered by decreasing alignment, so rows have no inner padding.
+
+namespace hot_cold {
+
+    struct Hot {};
+
+    struct Cold {};
+
+}  // namespace hot_cold
+
+namespace detail::hot_cold {
+
+    template <class T, std::size_t I>
+    using FieldOf = typename Describe<T>::template Field<I>;
+
+    template <class T, std::size_t I>
+    using FieldType = typename FieldOf<T, I>::Type;
+
+    template <class T>
+    constexpr bool any_hot = []<std::size_t... I>(std::index_sequence<I...>) {
+        return (FieldOf<T, I>::template has_annotation_class<::hot_cold::Hot> || ...);
+    }(std::make_index_sequence<Describe<T>::num_fields>());
+
+    template <class T, std::size_t I>
+    constexpr bool is_hot = [] {
+        using Field = FieldOf<T, I>;
+        constexpr bool hot = Field::template has_annotation_class<::hot_cold::Hot>;
+        constexpr bool cold = Field::template has_annotation_class<::hot_cold::Cold>;
+        static_assert(!(hot && cold), "field is annotated both Hot and Cold");
+        return hot || (!any_hot<T> && !cold);
+    }();
+
+    // Placement of the fields of one part inside its rows
+    template <class T, bool hot>
+    struct Part {
+        static constexpr std::size_t num_fields = Describe<T>::num_fields;
+
+        struct Tables {
+            std::size_t count = 0;
+            std::size_t stride = 0;
+            std::size_t alignment = 1;
+            std::array<bool, num_fields> member{};
+            std::array<std::size_t, num_fields> offset{};
+        };
+
+        static constexpr Tables tables = [] {
+            Tables result;
+            std::array<std::size_t, num_fields> sizes{};
+            std::array<std::size_t, num_fields> alignments{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((result.member[I] = is_hot<T, I> == hot, sizes[I] = sizeof(FieldType<T, I>), alignments[I] = alignof(FieldType<T, I>)), ...);
+            }(std::make_index_sequence<num_fields>());
+
+            for (std::size_t i = 0; i < num_fields; ++i) {
+                if (result.member[i]) {
+                    ++result.count;
+                    result.alignment = std::max(result.alignment, alignments[i]);
+                }
+            }
+            // sizes are multiples of alignments, so every field lands aligned
+            for (std::size_t alignment = result.alignment; alignment != 0; alignment /= 2) {
+                for (std::size_t i = 0; i < num_fields; ++i) {
+                    if (result.member[i] && alignments[i] == alignment) {
+                        result.offset[i] = result.stride;
+                        result.stride += sizes[i];
+                    }
+                }
+            }
+            result.stride = (result.stride + result.alignment - 1) / result.alignment * result.alignment;
+            return result;
+        }();
+
+        static constexpr std::size_t stride = tables.stride;
+        static constexpr std::size_t alignment = std::max(tables.alignment, alignof(std::max_align_t));
+        static constexpr bool empty = tables.count == 0;
+    };
+
+}  // namespace detail::hot_cold
+
+
+template <class T>
+class HotColdVector {
+    using Reflection = Describe<T>;
+    using HotPart = detail::hot_cold::Part<T, true>;
+    using ColdPart = detail::hot_cold::Part<T, false>;
+
+    template <std::size_t I>
+    using FieldType = detail::hot_cold::FieldType<T, I>;
+
+    template <std::size_t I>
+    using PartOf = std::conditional_t<detail::hot_cold::is_hot<T, I>, HotPart, ColdPart>;
+
+    // A row seen through both parts
+    template <bool is_const>
+    class RowImpl {
+        using Owner = std::conditional_t<is_const, const HotColdVector, HotColdVector>;
+
+    public:
+        RowImpl(Owner& owner, std::size_t index) noexcept : owner_(&owner), index_(index) {}
+
+        RowImpl(const RowImpl&) = default;
+
+        // Field I of the row, wherever it is stored
+        template <std::size_t I>
+        auto& Get() const noexcept {
+            if constexpr (is_const) {
+                return static_cast<const FieldType<I>&>(owner_->template FieldAt<I>(index_));
+            } else {
+                return owner_->template FieldAt<I>(index_);
+            }
+        }
+
+        // Copies the row out
+        operator T() const {
+            return owner_->Load(index_);
+        }
+
+        const RowImpl& operator=(const T& value) const
+        requires (!is_const) {
+            owner_->Store(index_, value);
+            return *this;
+        }
+
+        // Row assignment copies the fields, the proxy keeps pointing at its own row
+        const RowImpl& operator=(const RowImpl& other) const
+        requires (!is_const) {
+            return Assign(other);
+        }
+
+        const RowImpl& operator=(const RowImpl<!is_const>& other) const
+        requires (!is_const) {
+            return Assign(other);
+        }
+
+        std::size_t Index() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <bool other_const>
+        const RowImpl& Assign(const RowImpl<other_const>& other) const {
+            ForEachField([&]<std::size_t I>() {
+                Get<I>() = other.template Get<I>();
+            });
+            return *this;
+        }
+
+        Owner* owner_;
+        std::size_t index_;
+    };
+
+public:
+
+    // Typedefs
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = RowImpl<false>;
+    using const_reference = RowImpl<true>;
+
+    // Bytes per row of each part
+    static constexpr std::size_t hot_stride = HotPart::stride;
+    static constexpr std::size_t cold_stride = ColdPart::stride;
+
+    // Constructors
+
+    HotColdVector() = default;
+
+    // Delegates so that the destructor releases the rows already copied if a copy throws
+    HotColdVector(const HotColdVector& other) : HotColdVector() {
+        Reserve(other.size_);
+        for (; size_ < other.size_; ++size_) {
+            ConstructRow(size_, [&]<std::size_t I>() -> decltype(auto) {
+                return std::as_const(other.template FieldAt<I>(size_));
+            });
+        }
+    }
+
+    HotColdVector(HotColdVector&& other) noexcept
+        : hot_(std::exchange(other.hot_, nullptr)),
+          cold_(std::exchange(other.cold_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+
+    }
+
+    HotColdVector& operator=(HotColdVector other) noexcept {
+        std::swap(hot_, other.hot_);
+        std::swap(cold_, other.cold_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~HotColdVector() {
+        Clear();
+        Deallocate<HotPart>(hot_);
+        Deallocate<ColdPart>(cold_);
+    }
+
+    // Element access
+
+    reference operator[](std::size_t index) noexcept {
+        return reference(*this, index);
+    }
+
+    const_reference operator[](std::size_t index) const noexcept {
+        return const_reference(*this, index);
+    }
+
+    // Observers
+
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    std::size_t size() const noexcept {  // for STL compatibility
+        return Size();
+    }
+
+    std::size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Field I is stored in the hot part
+    template <std::size_t I>
+    static constexpr bool is_hot = detail::hot_cold::is_hot<T, I>;
+
+    // Modifiers
+
+    void Reserve(std::size_t capacity) {
+        if (capacity <= capacity_) return;
+        std::byte* hot = Allocate<HotPart>(capacity);
+        std::byte* cold;
+        try {
+            cold = Allocate<ColdPart>(capacity);
+        } catch (...) {
+            Deallocate<HotPart>(hot);
+            throw;
+        }
+        for (std::size_t index = 0; index < size_; ++index) {
+            ForEachField([&]<std::size_t I>() {
+                auto& from = FieldAt<I>(index);
+                std::byte* base = detail::hot_cold::is_hot<T, I> ? hot : cold;
+                std::construct_at(FieldPointer<I>(base, index), std::move(from));
+                std::destroy_at(&from);
+            });
+        }
+        Deallocate<HotPart>(hot_);
+        Deallocate<ColdPart>(cold_);
+        hot_ = hot;
+        cold_ = cold;
+        capacity_ = capacity;
+    }
+
+    void PushBack(const T& value) {
+        Grow();
+        ConstructRow(size_, [&]<std::size_t I>() -> decltype(auto) {
+            return Reflection::template Get<I>(value);
+        });
+        ++size_;
+    }
+
+    void PushBack(T&& value) {
+        Grow();
+        ConstructRow(size_, [&]<std::size_t I>() -> decltype(auto) {
+            return std::move(Reflection::template Get<I>(value));
+        });
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        --size_;
+        ForEachField([&]<std::size_t I>() {
+            std::destroy_at(&FieldAt<I>(size_));
+        });
+    }
+
+    // Removes row `index`, later rows move up by one
+    void Erase(std::size_t index) {
+        for (std::size_t row = index + 1; row < size_; ++row) {
+            ForEachField([&]<std::size_t I>() {
+                FieldAt<I>(row - 1) = std::move(FieldAt<I>(row));
+            });
+        }
+        PopBack();
+    }
+
+    void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    // STL-style names
+
+    void reserve(std::size_t capacity) {
+        Reserve(capacity);
+    }
+
+    void push_back(const T& value) {
+        PushBack(value);
+    }
+
+    void push_back(T&& value) {
+        PushBack(std::move(value));
+    }
+
+    void erase(std::size_t index) {
+        Erase(index);
+    }
+
+private:
+    template <class F>
+    static void ForEachField(F&& f) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f.template operator()<I>(), ...);
+        }(std::make_index_sequence<Reflection::num_fields>());
+    }
+
+    template <std::size_t I>
+    static FieldType<I>* FieldPointer(std::byte* base, std::size_t index) noexcept {
+        return std::launder(reinterpret_cast<FieldType<I>*>(base + index * PartOf<I>::stride + PartOf<I>::tables.offset[I]));
+    }
+
+    template <std::size_t I>
+    FieldType<I>& FieldAt(std::size_t index) const noexcept {
+        return *FieldPointer<I>(detail::hot_cold::is_hot<T, I> ? hot_ : cold_, index);
+    }
+
+    // Constructs field I of row `index` from source.template operator()<I>().
+    // If a constructor throws, the fields already constructed are destroyed and the row stays empty.
+    template <class Source>
+    void ConstructRow(std::size_t index, Source&& source) {
+        std::size_t constructed = 0;
+        try {
+            ForEachField([&]<std::size_t I>() {
+                std::construct_at(&FieldAt<I>(index), source.template operator()<I>());
+                ++constructed;
+            });
+        } catch (...) {
+            ForEachField([&]<std::size_t I>() {
+                if (I < constructed) {
+                    std::destroy_at(&FieldAt<I>(index));
+                }
+            });
+            throw;
+        }
+    }
+
+    T Load(std::size_t index) const {
+        T value{};
+        ForEachField([&]<std::size_t I>() {
+            Reflection::template Get<I>(value) = FieldAt<I>(index);
+        });
+        return value;
+    }
+
+    void Store(std::size_t index, const T& value) {
+        ForEachField([&]<std::size_t I>() {
+            FieldAt<I>(index) = Reflection::template Get<I>(value);
+        });
+    }
+
+    void Grow() {
+        if (size_ == capacity_) {
+            Reserve(std::max<std::size_t>(capacity_ * 2, 8));
+        }
+    }
+
+    template <class Part>
+    static std::byte* Allocate(std::size_t capacity) {
+        if constexpr (Part::empty) {
+            return nullptr;
+        } else {
+            return static_cast<std::byte*>(::operator new(capacity * Part::stride, std::align_val_t{Part::alignment}));
+        }
+    }
+
+    template <class Part>
+    static void Deallocate(std::byte* block) noexcept {
+        if (block != nullptr) {
+            ::operator delete(block, std::align_val_t{Part::alignment});
+        }
+    }
+
+    std::byte* hot_ = nullptr;
+    std::byte* cold_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <reflect.hpp>
+
+// Memberwise Copy, Equal, Hash and Zero for aggregates that Describe<T> understands.
+//
+//   struct Key { std::uint32_t tenant; std::uint32_t shard; std::uint64_t id; double weight; };
+//   memberwise::Equal(a, b);   // one 16-byte memcmp for tenant..id, then weight == weight
+//
+// Adjacent fields that can be handled as raw bytes are merged into one run using the layout
+// computed by Describe (see Describe::Runs), so padding and annotation members are never touched.
+// Copy and Zero merge trivially copyable fields. Equal and Hash merge fields whose value is
+// exactly their bytes (scalars with unique object representations and aggregates made of them),
+// so the results agree with comparing field by field. Other fields use their own operators,
+// nested aggregates are handled recursively.
+
+namespace detail::memberwise {
+
+    template <class U>
+    struct IsArray : std::false_type {};
+
+    template <class E, std::size_t N>
+    struct IsArray<std::array<E, N>> : std::true_type {};
+
+    template <class U>
+    concept Described = std::is_class_v<U> && std::is_aggregate_v<U> && !IsArray<U>::value;
+
+    template <class T>
+    struct Plan;
+
+    // Equal values have equal bytes and vice versa
+    template <class U>
+    constexpr bool Bytewise() {
+        if constexpr (!std::has_unique_object_representations_v<U>) {
+            return false;
+        } else if constexpr (std::is_scalar_v<U>) {
+            return true;
+        } else if constexpr (IsArray<U>::value) {
+            return Bytewise<typename U::value_type>();
+        } else if constexpr (Described<U>) {
+            return Plan<U>::bytewise;
+        } else {
+            return false;
+        }
+    }
+
+    template <class T>
+    struct Plan {
+        using Reflection = Describe<T>;
+        static constexpr std::size_t num_fields = Reflection::num_fields;
+
+        template <std::size_t I>
+        using FieldType = typename Reflection::template Field<I>::Type;
+
+        static constexpr std::array<bool, num_fields> trivial = [] {
+            std::array<bool, num_fields> result{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((result[I] = std::is_trivially_copyable_v<FieldType<I>>), ...);
+            }(std::make_index_sequence<num_fields>());
+            return result;
+        }();
+
+        static constexpr std::array<bool, num_fields> bytewise_fields = [] {
+            std::array<bool, num_fields> result{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((result[I] = Bytewise<FieldType<I>>()), ...);
+            }(std::make_index_sequence<num_fields>());
+            return result;
+        }();
+
+        static constexpr std::array<std::size_t, num_fields> copy_runs = Reflection::Runs(trivial);
+        static constexpr std::array<std::size_t, num_fields> compare_runs = Reflection::Runs(bytewise_fields);
+
+        // The whole object is one run without padding
+        static constexpr bool bytewise = num_fields > 0 && compare_runs[0] == sizeof(T);
+    };
+
+    template <class T, class F>
+    constexpr void ForEachField(F&& f) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (f(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<Describe<T>::num_fields>());
+    }
+
+    inline std::uint64_t Mix(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+        unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+        return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+    }
+
+    inline constexpr std::uint64_t kSeed = 0x9e3779b97f4a7c15ull;
+    inline constexpr std::uint64_t kMultiplier = 0xe7037ed1a0b428dbull;
+
+    // size is a compile-time constant at every call site, so the loop is unrolled
+    inline std::uint64_t HashBytes(std::uint64_t hash, const void* data, std::size_t size) noexcept {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (; size >= 8; bytes += 8, size -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            hash = Mix(hash ^ word, kMultiplier);
+        }
+        if (size != 0) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes, size);
+            hash = Mix(hash ^ word ^ (static_cast<std::uint64_t>(size) << 56), kMultiplier);
+        }
+        return hash;
+    }
+
+}  // namespace detail::memberwise
+
+
+namespace memberwise {
+
+    // dst = src field by field
+    template <class T>
+    requires detail::memberwise::Described<T>
+    void Copy(T& dst, const T& src) {
+        using Plan = detail::memberwise::Plan<T>;
+        using Reflection = Describe<T>;
+        detail::memberwise::ForEachField<T>([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (Plan::copy_runs[I] != 0) {
+                std::memcpy(&Reflection::template Get<I>(dst), &Reflection::template Get<I>(src), Plan::copy_runs[I]);
+            } else if constexpr (!Plan::trivial[I]) {
+                if constexpr (detail::memberwise::Described<typename Plan::template FieldType<I>>) {
+                    Copy(Reflection::template Get<I>(dst), Reflection::template Get<I>(src));
+                } else {
+                    Reflection::template Get<I>(dst) = Reflection::template Get<I>(src);
+                }
+            }
+        });
+    }
+
+    // All fields equal
+    template <class T>
+    requires detail::memberwise::Described<T>
+    bool Equal(const T& lhs, const T& rhs) {
+        using Plan = detail::memberwise::Plan<T>;
+        using Reflection = Describe<T>;
+        bool equal = true;
+        detail::memberwise::ForEachField<T>([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if (!equal) return;
+            if constexpr (Plan::compare_runs[I] != 0) {
+                equal = std::memcmp(&Reflection::template Get<I>(lhs), &Reflection::template Get<I>(rhs), Plan::compare_runs[I]) == 0;
+            } else if constexpr (!Plan::bytewise_fields[I]) {
+                if constexpr (detail::memberwise::Described<typename Plan::template FieldType<I>>) {
+                    equal = Equal(Reflection::template Get<I>(lhs), Reflection::template Get<I>(rhs));
+                } else {
+                    equal = Reflection::template Get<I>(lhs) == Reflection::template Get<I>(rhs);
+                }
+            }
+        });
+        return equal;
+    }
+
+    // Hash of all fields, consistent with Equal
+    template <class T>
+    requires detail::memberwise::Described<T>
+    std::uint64_t Hash(const T& value, std::uint64_t seed = detail::memberwise::kSeed) {
+        using Plan = detail::memberwise::Plan<T>;
+        using Reflection = Describe<T>;
+        std::uint64_t hash = seed;
+        detail::memberwise::ForEachField<T>([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (Plan::compare_runs[I] != 0) {
+                hash = detail::memberwise::HashBytes(hash, &Reflection::template Get<I>(value), Plan::compare_runs[I]);
+            } else if constexpr (!Plan::bytewise_fields[I]) {
+                using Field = typename Plan::template FieldType<I>;
+                if constexpr (detail::memberwise::Described<Field>) {
+                    hash = Hash(Reflection::template Get<I>(value), hash);
+                } else {
+                    hash = detail::memberwise::Mix(hash ^ std::hash<Field>{}(Reflection::template Get<I>(value)), detail::memberwise::kMultiplier);
+                }
+            }
+        });
+        return hash;
+    }
+
+    // Every field value-initialized, trivially copyable runs are cleared with memset
+    template <class T>
+    requires detail::memberwise::Described<T>
+    void Zero(T& value) {
+        using Plan = detail::memberwise::Plan<T>;
+        using Reflection = Describe<T>;
+        detail::memberwise::ForEachField<T>([&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+            if constexpr (Plan::copy_runs[I] != 0) {
+                std::memset(&Reflection::template Get<I>(value), 0, Plan::copy_runs[I]);
+            } else if constexpr (!Plan::trivial[I]) {
+                using Field = typename Plan::template FieldType<I>;
+                if constexpr (detail::memberwise::Described<Field>) {
+                    Zero(Reflection::template Get<I>(value));
+                } else {
+                    Reflection::template Get<I>(value) = Field{};
+                }
+            }
+        });
+    }
+
+    // Function objects for hashed containers
+
+    struct Hasher {
+        template <class T>
+        std::size_t operator()(const T& value) const {
+            return static_cast<std::size_t>(Hash(value));
+        }
+    };
+
+    struct EqualTo {
+        template <class T>
+        bool operator()(const T& lhs, const T& rhs) const {
+            return Equal(lhs, rhs);
+        }
+    };
+
+}  // namespace memberwise
@@ -0,0 +1,457 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Span.hpp>
+#include <reflect.hpp>
+
+// Binary serialization of aggregates, generated from Describe<T>.
+//
+//   struct Header {
+//       std::uint32_t id;
+//       std::uint16_t kind;
+//       std::uint16_t flags;
+//       Annotate<serialization::Varint> _1;
+//       std::uint64_t length;
+//       Annotate<serialization::BigEndian> _2;
+//       std::uint32_t checksum;
+//       std::string name;
+//   };
+//
+//   std::size_t written = serialization::Encode(header, buffer);
+//   std::size_t read = serialization::Decode(buffer.First(written), header);
+//
+// Fields are written in declaration order without padding:
+//   - trivially copyable fields as their bytes in native order. Neighbouring fields with no padding
+//     in between are copied with one memcpy, so id, kind and flags above are a single 8-byte copy
+//   - Varint: LEB128 for unsigned integers, zigzag LEB128 for signed ones
+//   - BigEndian / LittleEndian: fixed-width integers, floats or enums in the given byte order
+//   - Skip: not written, left untouched when decoding
+//   - std::string and std::vector: varint length followed by the elements
+//   - other aggregates recursively
+// Encode writes into the caller's buffer and throws std::length_error if it is too small,
+// Decode throws std::out_of_range on truncated input.
+
+namespace serialization {
+
+    struct Varint {};
+    struct BigEndian {};
+    struct LittleEndian {};
+    struct Skip {};
+
+}  // namespace serialization
+
+
+namespace detail::serialization {
+
+    namespace annotations = ::serialization;
+
+    class Writer {
+    public:
+        explicit Writer(Span<std::byte> out) noexcept : begin_(out.Data()), cursor_(out.Data()), end_(out.Data() + out.Size()) {}
+
+        void Write(const void* data, std::size_t size) {
+            if (static_cast<std::size_t>(end_ - cursor_) < size) {
+                throw std::length_error("serialization: output buffer is too small");
+            }
+            if (size != 0) {
+                std::memcpy(cursor_, data, size);
+            }
+            cursor_ += size;
+        }
+
+        void WriteByte(std::byte value) {
+            Write(&value, 1);
+        }
+
+        // Skips size bytes that are filled in later through the returned pointer
+        std::byte* Reserve(std::size_t size) {
+            if (static_cast<std::size_t>(end_ - cursor_) < size) {
+                throw std::length_error("serialization: output buffer is too small");
+            }
+            std::byte* reserved = cursor_;
+            cursor_ += size;
+            return reserved;
+        }
+
+        // Drops everything written after the first `written` bytes
+        void Rewind(std::size_t written) noexcept {
+            cursor_ = begin_ + written;
+        }
+
+        std::size_t Written() const noexcept {
+            return static_cast<std::size_t>(cursor_ - begin_);
+        }
+
+    private:
+        std::byte* begin_;
+        std::byte* cursor_;
+        std::byte* end_;
+    };
+
+    class Reader {
+    public:
+        explicit Reader(Span<const std::byte> in) noexcept : begin_(in.Data()), cursor_(in.Data()), end_(in.Data() + in.Size()) {}
+
+        void Read(void* data, std::size_t size) {
+            if (static_cast<std::size_t>(end_ - cursor_) < size) {
+                throw std::out_of_range("serialization: input is truncated");
+            }
+            if (size != 0) {
+                std::memcpy(data, cursor_, size);
+            }
+            cursor_ += size;
+        }
+
+        std::byte ReadByte() {
+            std::byte value;
+            Read(&value, 1);
+            return value;
+        }
+
+        std::size_t Consumed() const noexcept {
+            return static_cast<std::size_t>(cursor_ - begin_);
+        }
+
+    private:
+        const std::byte* begin_;
+        const std::byte* cursor_;
+        const std::byte* end_;
+    };
+
+    // Type classification
+
+    template <class U>
+    struct IsString : std::false_type {};
+
+    template <class C, class Traits, class Alloc>
+    struct IsString<std::basic_string<C, Traits, Alloc>> : std::true_type {};
+
+    template <class U>
+    struct IsVector : std::false_type {};
+
+    template <class E, class Alloc>
+    struct IsVector<std::vector<E, Alloc>> : std::true_type {};
+
+    template <class U>
+    concept Sequence = IsString<U>::value || IsVector<U>::value;
+
+    template <class U>
+    struct IsArray : std::false_type {};
+
+    template <class E, std::size_t N>
+    struct IsArray<std::array<E, N>> : std::true_type {};
+
+    template <class U>
+    concept Integer = (std::is_integral_v<U> && !std::is_same_v<U, bool>) || std::is_enum_v<U>;
+
+    // Aggregates are encoded field by field (runs of plain fields still become one copy),
+    // everything else that is trivially copyable as its bytes
+    template <class U>
+    concept Described = std::is_class_v<U> && std::is_aggregate_v<U> && !IsArray<U>::value && !Sequence<U>;
+
+    template <class U>
+    concept Bytes = std::is_trivially_copyable_v<U> && !Described<U>;
+
+    template <class Field>
+    constexpr bool is_skipped = Field::template has_annotation_class<annotations::Skip>;
+
+    template <class Field>
+    constexpr bool is_varint = Field::template has_annotation_class<annotations::Varint>;
+
+    template <class Field>
+    constexpr bool is_big_endian = Field::template has_annotation_class<annotations::BigEndian>;
+
+    template <class Field>
+    constexpr bool is_little_endian = Field::template has_annotation_class<annotations::LittleEndian>;
+
+    // Field that is copied as its native bytes
+    template <class Field>
+    constexpr bool is_plain = Bytes<typename Field::Type> && !is_skipped<Field> && !is_varint<Field> && !is_big_endian<Field> && !is_little_endian<Field>;
+
+    // Plain runs over the layout computed by Describe
+
+    template <class T>
+    struct Layout {
+        using Reflection = Describe<T>;
+        static constexpr std::size_t num_fields = Reflection::num_fields;
+
+        template <std::size_t I>
+        using Field = typename Reflection::template Field<I>;
+
+        static constexpr std::array<bool, num_fields> plain = [] {
+            std::array<bool, num_fields> result{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((result[I] = is_plain<Field<I>>), ...);
+            }(std::make_index_sequence<num_fields>());
+            return result;
+        }();
+
+        // Bytes of the plain run starting at field I, see Describe::Runs
+        static constexpr std::array<std::size_t, num_fields> run_bytes = Reflection::Runs(plain);
+
+        // The encoding of T is exactly its memory image
+        static constexpr bool in_place = num_fields > 0 && run_bytes[0] == sizeof(T);
+    };
+
+    template <class U>
+    void EncodeValue(Writer& writer, const U& value);
+
+    template <class U>
+    void DecodeValue(Reader& reader, U& value);
+
+    // Varints
+
+    template <class U>
+    using Underlying = typename std::conditional_t<std::is_enum_v<U>, std::underlying_type<U>, std::type_identity<U>>::type;
+
+    // Signed values are zigzag mapped, so small negative numbers stay short
+    template <Integer U>
+    auto ZigZag(U value) noexcept {
+        using Unsigned = std::make_unsigned_t<Underlying<U>>;
+        auto raw = static_cast<Underlying<U>>(value);
+        if constexpr (std::is_signed_v<Underlying<U>>) {
+            return static_cast<Unsigned>((static_cast<Unsigned>(raw) << 1) ^ static_cast<Unsigned>(raw >> (sizeof(raw) * 8 - 1)));
+        } else {
+            return static_cast<Unsigned>(raw);
+        }
+    }
+
+    template <Integer U, class Unsigned>
+    U UnZigZag(Unsigned bits) noexcept {
+        if constexpr (std::is_signed_v<Underlying<U>>) {
+            return static_cast<U>(static_cast<Underlying<U>>((bits >> 1) ^ (~(bits & 1) + 1)));
+        } else {
+            return static_cast<U>(bits);
+        }
+    }
+
+    inline void WriteVarint(Writer& writer, std::uint64_t value) {
+        std::byte buffer[10];
+        std::size_t size = 0;
+        do {
+            std::uint8_t byte = value & 0x7f;
+            value >>= 7;
+            buffer[size++] = static_cast<std::byte>(value != 0 ? byte | 0x80 : byte);
+        } while (value != 0);
+        writer.Write(buffer, size);
+    }
+
+    inline std::uint64_t ReadVarint(Reader& reader) {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            auto byte = static_cast<std::uint8_t>(reader.ReadByte());
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        throw std::out_of_range("serialization: malformed varint");
+    }
+
+    // Fixed byte order
+
+    template <class U>
+    U ByteSwap(U value) noexcept {
+        std::array<std::byte, sizeof(U)> bytes;
+        std::memcpy(bytes.data(), &value, sizeof(U));
+        for (std::size_t i = 0; i < sizeof(U) / 2; ++i) {
+            std::swap(bytes[i], bytes[sizeof(U) - 1 - i]);
+        }
+        std::memcpy(&value, bytes.data(), sizeof(U));
+        return value;
+    }
+
+    template <std::endian order, class U>
+    void WriteOrdered(Writer& writer, U value) {
+        if constexpr (order != std::endian::native) {
+            value = ByteSwap(value);
+        }
+        writer.Write(&value, sizeof(U));
+    }
+
+    template <std::endian order, class U>
+    void ReadOrdered(Reader& reader, U& value) {
+        reader.Read(&value, sizeof(U));
+        if constexpr (order != std::endian::native) {
+            value = ByteSwap(value);
+        }
+    }
+
+    // Fields
+
+    template <class Field, class U>
+    void EncodeField(Writer& writer, const U& value) {
+        if constexpr (is_skipped<Field>) {
+            return;
+        } else if constexpr (is_varint<Field>) {
+            static_assert(Integer<U>, "Varint applies to integers and enums");
+            WriteVarint(writer, ZigZag(value));
+        } else if constexpr (is_big_endian<Field> || is_little_endian<Field>) {
+            static_assert(std::is_arithmetic_v<U> || std::is_enum_v<U>, "Byte order applies to numbers and enums");
+            WriteOrdered<is_big_endian<Field> ? std::endian::big : std::endian::little>(writer, value);
+        } else {
+            EncodeValue(writer, value);
+        }
+    }
+
+    template <class Field, class U>
+    void DecodeField(Reader& reader, U& value) {
+        if constexpr (is_skipped<Field>) {
+            return;
+        } else if constexpr (is_varint<Field>) {
+            value = UnZigZag<U>(static_cast<decltype(ZigZag(value))>(ReadVarint(reader)));
+        } else if constexpr (is_big_endian<Field> || is_little_endian<Field>) {
+            ReadOrdered<is_big_endian<Field> ? std::endian::big : std::endian::little>(reader, value);
+        } else {
+            DecodeValue(reader, value);
+        }
+    }
+
+    // Aggregates: runs of plain fields are one copy, other fields are encoded one by one,
+    // plain fields inside a run are covered by the copy of the run
+
+    template <class T>
+    void EncodeFields(Writer& writer, const T& value) {
+        using L = Layout<T>;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            auto encode = [&]<std::size_t F>(std::integral_constant<std::size_t, F>) {
+                if constexpr (L::run_bytes[F] != 0) {
+                    writer.Write(&Describe<T>::template Get<F>(value), L::run_bytes[F]);
+                } else if constexpr (!L::plain[F]) {
+                    EncodeField<typename L::template Field<F>>(writer, Describe<T>::template Get<F>(value));
+                }
+            };
+            (encode(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<L::num_fields>());
+    }
+
+    template <class T>
+    void DecodeFields(Reader& reader, T& value) {
+        using L = Layout<T>;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            auto decode = [&]<std::size_t F>(std::integral_constant<std::size_t, F>) {
+                if constexpr (L::run_bytes[F] != 0) {
+                    reader.Read(&Describe<T>::template Get<F>(value), L::run_bytes[F]);
+                } else if constexpr (!L::plain[F]) {
+                    DecodeField<typename L::template Field<F>>(reader, Describe<T>::template Get<F>(value));
+                }
+            };
+            (decode(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<L::num_fields>());
+    }
+
+    // Values without annotations
+
+    template <class U>
+    void EncodeValue(Writer& writer, const U& value) {
+        if constexpr (Bytes<U>) {
+            writer.Write(&value, sizeof(U));
+        } else if constexpr (Sequence<U>) {
+            using Element = typename U::value_type;
+            WriteVarint(writer, value.size());
+            if constexpr (Bytes<Element>) {
+                writer.Write(value.data(), value.size() * sizeof(Element));
+            } else {
+                for (const auto& element : value) {
+                    EncodeValue(writer, element);
+                }
+            }
+        } else {
+            static_assert(Described<U>, "Only aggregates, strings, vectors and trivially copyable types can be serialized");
+            EncodeFields(writer, value);
+        }
+    }
+
+    template <class U>
+    void DecodeValue(Reader& reader, U& value) {
+        if constexpr (Bytes<U>) {
+            reader.Read(&value, sizeof(U));
+        } else if constexpr (Sequence<U>) {
+            using Element = typename U::value_type;
+            std::size_t size = ReadVarint(reader);
+            if constexpr (Bytes<Element>) {
+                if (size > (std::size_t{1} << 48) / sizeof(Element)) {
+                    throw std::out_of_range("serialization: malformed length");
+                }
+                value.resize(size);
+                reader.Read(value.data(), size * sizeof(Element));
+            } else {
+                value.clear();
+                for (std::size_t i = 0; i < size; ++i) {
+                    DecodeValue(reader, value.emplace_back());
+                }
+            }
+        } else {
+            DecodeFields(reader, value);
+        }
+    }
+
+}  // namespace detail::serialization
+
+
+namespace serialization {
+
+    // The encoding of T is its memory image, so encoded bytes can be used in place
+    template <class T>
+    concept InPlace = std::is_aggregate_v<T> && std::is_trivially_copyable_v<T> && ::detail::serialization::Layout<T>::in_place;
+
+    // Writes value into out, returns the number of bytes written
+    template <class T>
+    std::size_t Encode(const T& value, Span<std::byte> out) {
+        ::detail::serialization::Writer writer(out);
+        ::detail::serialization::EncodeValue(writer, value);
+        return writer.Written();
+    }
+
+    // Reads value from the front of in, returns the number of bytes consumed
+    template <class T>
+    std::size_t Decode(Span<const std::byte> in, T& value) {
+        ::detail::serialization::Reader reader(in);
+        ::detail::serialization::DecodeValue(reader, value);
+        return reader.Consumed();
+    }
+
+    template <class T>
+    T Decode(Span<const std::byte> in) {
+        T value{};
+        Decode(in, value);
+        return value;
+    }
+
+    // Object encoded at the front of in, without copying. The bytes must be suitably aligned for T.
+    template <InPlace T>
+    const T& View(Span<const std::byte> in) {
+        if (in.Size() < sizeof(T)) {
+            throw std::out_of_range("serialization: input is truncated");
+        }
+        if (reinterpret_cast<std::uintptr_t>(in.Data()) % alignof(T) != 0) {
+            throw std::invalid_argument("serialization: input is not aligned for an in-place view");
+        }
+        return *std::launder(reinterpret_cast<const T*>(in.Data()));
+    }
+
+    // Views of count consecutive encoded objects
+    template <InPlace T>
+    Span<const T> ViewArray(Span<const std::byte> in, std::size_t count) {
+        if (in.Size() / sizeof(T) < count) {
+            throw std::out_of_range("serialization: input is truncated");
+        }
+        if (reinterpret_cast<std::uintptr_t>(in.Data()) % alignof(T) != 0) {
+            throw std::invalid_argument("serialization: input is not aligned for an in-place view");
+        }
+        return Span<const T>(std::launder(reinterpret_cast<const T*>(in.Data())), count);
+    }
+
+}  // namespace serialization
@@ -0,0 +1,521 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Span.hpp>
+#include <reflect.hpp>
+
+// Struct-of-arrays container for aggregates that Describe<T> understands.
+//
+//   struct Order {
+//       std::uint64_t id;
+//       Annotate<soa::Group<Quote>> _1;
+//       double price;
+//       Annotate<soa::Group<Quote>> _2;
+//       std::uint32_t quantity;
+//       Annotate<soa::Skip> _3;
+//       std::string comment;
+//   };
+//
+//   SoAVector<Order> orders;
+//   std::uint64_t last = Max(orders.Column<0>());            // SpanKernels.hpp
+//
+// Every field lives in its own column, so a scan over one field reads only that field.
+// Annotations apply to the field that follows them:
+//   - soa::Skip         the field is not stored, rows read back a value-initialized field
+//   - soa::Group<Tag>   fields with the same Tag share one column of std::tuple, for fields
+//                       that are always read together
+// All columns live in one allocation, each starting on its own cache line.
+
+namespace soa {
+
+    struct Skip {};
+
+    template <class... Tag>
+    struct Group {};
+
+}  // namespace soa
+
+namespace detail::soa_layout {
+
+    inline constexpr std::size_t kColumnAlignment = 64;
+    inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    template <class T, std::size_t I>
+    using FieldOf = typename Describe<T>::template Field<I>;
+
+    template <class T, std::size_t I>
+    using FieldType = typename FieldOf<T, I>::Type;
+
+    template <class T, std::size_t I>
+    constexpr bool is_skipped = FieldOf<T, I>::template has_annotation_class<::soa::Skip>;
+
+    template <class Field, bool grouped = Field::template has_annotation_template<::soa::Group>>
+    struct GroupKeyImpl {
+        using Type = void;
+    };
+
+    template <class Field>
+    struct GroupKeyImpl<Field, true> {
+        using Type = typename Field::template FindAnnotation<::soa::Group>;
+    };
+
+    // Annotation that identifies the group of field I, void for fields with their own column
+    template <class T, std::size_t I>
+    using GroupKey = typename GroupKeyImpl<FieldOf<T, I>>::Type;
+
+    template <class T, std::size_t I, std::size_t J>
+    constexpr bool same_group = !std::is_void_v<GroupKey<T, I>> && std::is_same_v<GroupKey<T, I>, GroupKey<T, J>>;
+
+    // Field of an object, moved from if the object is an rvalue
+    template <class Object, class Field>
+    constexpr decltype(auto) ForwardLike(Field& field) noexcept {
+        if constexpr (std::is_lvalue_reference_v<Object>) {
+            return static_cast<const Field&>(field);
+        } else {
+            return std::move(field);
+        }
+    }
+
+    template <class T>
+    struct Layout {
+        static constexpr std::size_t num_fields = Describe<T>::num_fields;
+
+        // First stored field of every column, and for every field its column and position inside a group
+        struct Tables {
+            std::size_t num_columns = 0;
+            std::array<std::size_t, num_fields> leader{};
+            std::array<std::size_t, num_fields> column{};
+            std::array<std::size_t, num_fields> position{};
+        };
+
+        static constexpr Tables tables = [] {
+            Tables result;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                auto place = [&]<std::size_t F>(std::integral_constant<std::size_t, F>) {
+                    result.column[F] = npos;
+                    result.position[F] = npos;
+                    if constexpr (!is_skipped<T, F>) {
+                        // join the column of the first earlier field of the same group
+                        std::size_t earlier = npos;
+                        std::size_t position = 0;
+                        [&]<std::size_t... J>(std::index_sequence<J...>) {
+                            ((!is_skipped<T, J> && same_group<T, F, J> ? void((earlier = earlier == npos ? J : earlier, ++position)) : void()), ...);
+                        }(std::make_index_sequence<F>());
+                        if (earlier == npos) {
+                            result.leader[result.num_columns] = F;
+                            result.column[F] = result.num_columns++;
+                            result.position[F] = std::is_void_v<GroupKey<T, F>> ? npos : 0;
+                        } else {
+                            result.column[F] = result.column[earlier];
+                            result.position[F] = position;
+                        }
+                    }
+                };
+                (place(std::integral_constant<std::size_t, I>{}), ...);
+            }(std::make_index_sequence<num_fields>());
+            return result;
+        }();
+
+        static constexpr std::size_t num_columns = tables.num_columns;
+
+        template <std::size_t I>
+        static constexpr std::size_t column = tables.column[I];
+
+        template <std::size_t I>
+        static constexpr bool grouped = tables.position[I] != npos;
+
+        template <std::size_t C, std::size_t... I>
+        static auto GroupTuple(std::index_sequence<I...>)
+            -> decltype(std::tuple_cat(std::declval<std::conditional_t<tables.column[I] == C, std::tuple<FieldType<T, I>>, std::tuple<>>>()...));
+
+        // Element type of column C
+        template <std::size_t C, std::size_t leader = tables.leader[C]>
+        using ColumnElement = std::conditional_t<
+            grouped<leader>,
+            decltype(GroupTuple<C>(std::make_index_sequence<num_fields>())),
+            FieldType<T, leader>>;
+    };
+
+}  // namespace detail::soa_layout
+
+
+template <class T>
+class SoAVector {
+    using Layout = detail::soa_layout::Layout<T>;
+    using Reflection = Describe<T>;
+
+    static constexpr std::size_t num_columns = Layout::num_columns;
+    static constexpr std::size_t kAlignment = detail::soa_layout::kColumnAlignment;
+
+    template <std::size_t C>
+    using ColumnElement = typename Layout::template ColumnElement<C>;
+
+    template <std::size_t I>
+    using FieldType = detail::soa_layout::FieldType<T, I>;
+
+    template <bool is_const>
+    class RowImpl {
+        using Owner = std::conditional_t<is_const, const SoAVector, SoAVector>;
+
+    public:
+        RowImpl(Owner& owner, std::size_t index) noexcept : owner_(&owner), index_(index) {}
+
+        RowImpl(const RowImpl&) = default;
+
+        // Field I of the row, skipped fields are not accessible
+        template <std::size_t I>
+        auto& Get() const noexcept {
+            return owner_->template FieldAt<I>(index_);
+        }
+
+        // Copies the row out, skipped fields are value-initialized
+        operator T() const {
+            return owner_->Load(index_);
+        }
+
+        const RowImpl& operator=(const T& value) const
+        requires (!is_const) {
+            owner_->Store(index_, value);
+            return *this;
+        }
+
+        // Row assignment copies the stored fields, the proxy keeps pointing at its own row
+        const RowImpl& operator=(const RowImpl& other) const
+        requires (!is_const) {
+            return Assign(other);
+        }
+
+        const RowImpl& operator=(const RowImpl<!is_const>& other) const
+        requires (!is_const) {
+            return Assign(other);
+        }
+
+        std::size_t Index() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <bool other_const>
+        const RowImpl& Assign(const RowImpl<other_const>& other) const {
+            ForEachStoredField([&]<std::size_t I>() {
+                Get<I>() = other.template Get<I>();
+            });
+            return *this;
+        }
+
+        Owner* owner_;
+        std::size_t index_;
+    };
+
+public:
+
+    // Typedefs
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = RowImpl<false>;
+    using const_reference = RowImpl<true>;
+
+    // Constructors
+
+    SoAVector() = default;
+
+    // Delegates so that the destructor releases the rows already copied if a copy throws
+    SoAVector(const SoAVector& other) : SoAVector() {
+        Reserve(other.size_);
+        for (; size_ < other.size_; ++size_) {
+            ConstructRow(size_, [&]<std::size_t C>() -> decltype(auto) {
+                return std::as_const(other.template ColumnData<C>()[size_]);
+            });
+        }
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr)),
+          columns_(std::exchange(other.columns_, {})),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {
+
+    }
+
+    SoAVector& operator=(SoAVector other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    ~SoAVector() {
+        Clear();
+        Deallocate(block_);
+    }
+
+    // Element access
+
+    reference operator[](std::size_t index) noexcept {
+        return reference(*this, index);
+    }
+
+    const_reference operator[](std::size_t index) const noexcept {
+        return const_reference(*this, index);
+    }
+
+    // All values of field I, for fields with their own column
+    template <std::size_t I>
+    requires (!detail::soa_layout::is_skipped<T, I> && !Layout::template grouped<I>)
+    Span<FieldType<I>> Column() noexcept {
+        return Span<FieldType<I>>(ColumnData<Layout::template column<I>>(), size_);
+    }
+
+    template <std::size_t I>
+    requires (!detail::soa_layout::is_skipped<T, I> && !Layout::template grouped<I>)
+    Span<const FieldType<I>> Column() const noexcept {
+        return Span<const FieldType<I>>(ColumnData<Layout::template column<I>>(), size_);
+    }
+
+    // Shared column of the group that field I belongs to, one std::tuple per row
+    template <std::size_t I>
+    requires (Layout::template grouped<I>)
+    Span<ColumnElement<Layout::template column<I>>> GroupColumn() noexcept {
+        return Span<ColumnElement<Layout::template column<I>>>(ColumnData<Layout::template column<I>>(), size_);
+    }
+
+    template <std::size_t I>
+    requires (Layout::template grouped<I>)
+    Span<const ColumnElement<Layout::template column<I>>> GroupColumn() const noexcept {
+        return Span<const ColumnElement<Layout::template column<I>>>(ColumnData<Layout::template column<I>>(), size_);
+    }
+
+    // Observers
+
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    std::size_t size() const noexcept {  // for STL compatibility
+        return Size();
+    }
+
+    std::size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Modifiers
+
+    void Reserve(std::size_t capacity) {
+        if (capacity <= capacity_) return;
+        std::byte* block = Allocate(capacity);
+        std::array<void*, num_columns> columns = ColumnPointers(block, capacity);
+        ForEachColumn([&]<std::size_t C>() {
+            auto* from = ColumnData<C>();
+            std::uninitialized_move_n(from, size_, static_cast<ColumnElement<C>*>(columns[C]));
+            std::destroy_n(from, size_);
+        });
+        Deallocate(block_);
+        block_ = block;
+        columns_ = columns;
+        capacity_ = capacity;
+    }
+
+    void PushBack(const T& value) {
+        Grow();
+        ConstructRow(size_, [&]<std::size_t C>() {
+            return ColumnValue<C>(value);
+        });
+        ++size_;
+    }
+
+    void PushBack(T&& value) {
+        Grow();
+        ConstructRow(size_, [&]<std::size_t C>() {
+            return ColumnValue<C>(std::move(value));
+        });
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        --size_;
+        ForEachColumn([&]<std::size_t C>() {
+            std::destroy_at(ColumnData<C>() + size_);
+        });
+    }
+
+    // Removes row `index`, later rows move up by one
+    void Erase(std::size_t index) {
+        ForEachColumn([&]<std::size_t C>() {
+            auto* data = ColumnData<C>();
+            std::move(data + index + 1, data + size_, data + index);
+        });
+        PopBack();
+    }
+
+    void Clear() noexcept {
+        ForEachColumn([&]<std::size_t C>() {
+            std::destroy_n(ColumnData<C>(), size_);
+        });
+        size_ = 0;
+    }
+
+    // STL-style names
+
+    void reserve(std::size_t capacity) {
+        Reserve(capacity);
+    }
+
+    void push_back(const T& value) {
+        PushBack(value);
+    }
+
+    void push_back(T&& value) {
+        PushBack(std::move(value));
+    }
+
+    void erase(std::size_t index) {
+        Erase(index);
+    }
+
+private:
+    template <class F>
+    static void ForEachColumn(F&& f) {
+        [&]<std::size_t... C>(std::index_sequence<C...>) {
+            (f.template operator()<C>(), ...);
+        }(std::make_index_sequence<num_columns>());
+    }
+
+    template <class F>
+    static void ForEachStoredField(F&& f) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            auto visit = [&]<std::size_t J>(std::integral_constant<std::size_t, J>) {
+                if constexpr (!detail::soa_layout::is_skipped<T, J>) {
+                    f.template operator()<J>();
+                }
+            };
+            (visit(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<Reflection::num_fields>());
+    }
+
+    // Constructs column C of row `index` from source.template operator()<C>().
+    // If a constructor throws, the columns already constructed are destroyed and the row stays empty.
+    template <class Source>
+    void ConstructRow(std::size_t index, Source&& source) {
+        std::size_t constructed = 0;
+        try {
+            ForEachColumn([&]<std::size_t C>() {
+                std::construct_at(ColumnData<C>() + index, source.template operator()<C>());
+                ++constructed;
+            });
+        } catch (...) {
+            ForEachColumn([&]<std::size_t C>() {
+                if (C < constructed) {
+                    std::destroy_at(ColumnData<C>() + index);
+                }
+            });
+            throw;
+        }
+    }
+
+    template <std::size_t C>
+    ColumnElement<C>* ColumnData() const noexcept {
+        return static_cast<ColumnElement<C>*>(columns_[C]);
+    }
+
+    template <std::size_t I>
+    auto& FieldAt(std::size_t index) const noexcept {
+        auto& element = ColumnData<Layout::template column<I>>()[index];
+        if constexpr (Layout::template grouped<I>) {
+            return std::get<Layout::tables.position[I]>(element);
+        } else {
+            return element;
+        }
+    }
+
+    // Column C element of a row, built from the fields of value
+    template <std::size_t C, class Value>
+    static ColumnElement<C> ColumnValue(Value&& value) {
+        constexpr std::size_t leader = Layout::tables.leader[C];
+        if constexpr (Layout::template grouped<leader>) {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return std::tuple_cat(Member<C, I>(std::forward<Value>(value))...);
+            }(std::make_index_sequence<Reflection::num_fields>());
+        } else {
+            return ColumnElement<C>(detail::soa_layout::ForwardLike<Value>(Reflection::template Get<leader>(value)));
+        }
+    }
+
+    template <std::size_t C, std::size_t I, class Value>
+    static auto Member(Value&& value) {
+        if constexpr (Layout::template column<I> == C) {
+            return std::tuple<FieldType<I>>(detail::soa_layout::ForwardLike<Value>(Reflection::template Get<I>(value)));
+        } else {
+            return std::tuple<>();
+        }
+    }
+
+    T Load(std::size_t index) const {
+        T value{};
+        ForEachStoredField([&]<std::size_t I>() {
+            Reflection::template Get<I>(value) = FieldAt<I>(index);
+        });
+        return value;
+    }
+
+    void Store(std::size_t index, const T& value) {
+        ForEachStoredField([&]<std::size_t I>() {
+            FieldAt<I>(index) = Reflection::template Get<I>(value);
+        });
+    }
+
+    void Grow() {
+        if (size_ == capacity_) {
+            Reserve(std::max<std::size_t>(capacity_ * 2, 8));
+        }
+    }
+
+    // Column C starts at a multiple of kAlignment after the previous one
+    static std::array<std::size_t, num_columns + 1> ColumnOffsets(std::size_t capacity) noexcept {
+        std::array<std::size_t, num_columns + 1> offsets{};
+        [&]<std::size_t... C>(std::index_sequence<C...>) {
+            ((offsets[C + 1] = offsets[C] + (capacity * sizeof(ColumnElement<C>) + kAlignment - 1) / kAlignment * kAlignment), ...);
+        }(std::make_index_sequence<num_columns>());
+        return offsets;
+    }
+
+    static std::array<void*, num_columns> ColumnPointers(std::byte* block, std::size_t capacity) noexcept {
+        auto offsets = ColumnOffsets(capacity);
+        std::array<void*, num_columns> columns{};
+        for (std::size_t c = 0; c < num_columns; ++c) {
+            columns[c] = block + offsets[c];
+        }
+        return columns;
+    }
+
+    static std::byte* Allocate(std::size_t capacity) {
+        return static_cast<std::byte*>(::operator new(std::max<std::size_t>(ColumnOffsets(capacity).back(), 1), std::align_val_t{kAlignment}));
+    }
+
+    static void Deallocate(std::byte* block) noexcept {
+        if (block != nullptr) {
+            ::operator delete(block, std::align_val_t{kAlignment});
+        }
+    }
+
+    std::byte* block_ = nullptr;
+    std::array<void*, num_columns> columns_{};
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
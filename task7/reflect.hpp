@@ -2,7 +2,11 @@
 
 #include <bits/utility.h>
 #include <concepts>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <tuple>
 #include <type_traits>
 
 template <class...>
@@ -47,6 +51,9 @@ struct FieldDescriptor {
     using Type = Field;
     using Annotations = Annotate<Annos...>;
 
+    static constexpr std::size_t size = sizeof(Field);
+    static constexpr std::size_t alignment = alignof(Field);
+
     template <template <class...> class AnnotationTemplate>
     static constexpr bool has_annotation_template = (detail::is_specialization<Annos, AnnotationTemplate>::value || ...);
     
@@ -73,19 +80,6 @@ namespace detail {
     template <class T, std::size_t N>
     using LoopholeGet = decltype(loophole(Tag<T, N>{}));
 
-    template <typename T, std::size_t N>
-    struct FieldTag {
-        friend auto field_loophole(FieldTag<T, N>);
-    };
-
-    template <class T, std::size_t N, class F>
-    struct FieldLoopholeSet {
-        friend auto field_loophole(FieldTag<T, N>) { return F{}; };
-    };
-
-    template <class T, std::size_t N>
-    using FieldLoopholeGet = decltype(field_loophole(FieldTag<T, N>{}));
-
     template <std::size_t I>
     struct UbiqConstructor {
         template <class Type>
@@ -111,20 +105,253 @@ namespace detail {
     template <class Field>
     concept IsAnnotate = IsSpec<Field, Annotate>;
 
-    template <class T, std::size_t... I>
-    constexpr std::size_t CountRawFieldsImpl(std::index_sequence<I...>) {
-        return sizeof...(I) - 1;
+    template <class T, std::size_t N>
+    constexpr bool kConstructibleWith = []<std::size_t... I>(std::index_sequence<I...>) {
+        return AggregateConstructibleFrom<T, UbiqConstructor<I>...>;
+    }(std::make_index_sequence<N>());
+
+    // T is constructible from `low` arguments but not from `high`, so the count is in [low, high)
+    template <class T, std::size_t low, std::size_t high>
+    constexpr std::size_t CountRawFieldsSearch() {
+        if constexpr (high - low <= 1) {
+            return low;
+        } else if constexpr (kConstructibleWith<T, low + (high - low) / 2>) {
+            return CountRawFieldsSearch<T, low + (high - low) / 2, high>();
+        } else {
+            return CountRawFieldsSearch<T, low, low + (high - low) / 2>();
+        }
     }
 
-    template <class T, std::size_t... I>
-    requires (AggregateConstructibleFrom<T, UbiqConstructor<I>...>)
-    constexpr std::size_t CountRawFieldsImpl(std::index_sequence<I...>) {
-        return CountRawFieldsImpl<T>(std::index_sequence<0, I...>{});
+    inline constexpr std::size_t kRawFieldsProbeLimit = 1024;
+
+    // Largest number of arguments T can be aggregate-initialized from: the bound is doubled
+    // until a probe fails, then the count is binary searched, O(log N) probes in total
+    template <class T, std::size_t bound = 1>
+    constexpr std::size_t CountRawFields() {
+        static_assert(bound <= kRawFieldsProbeLimit, "Too many members");
+        if constexpr (kConstructibleWith<T, bound>) {
+            return CountRawFields<T, bound * 2>();
+        } else {
+            return CountRawFieldsSearch<T, bound / 2, bound>();
+        }
     }
 
-    template <class T, std::size_t I, std::size_t>
-    auto ForceCalculation() {
-        return detail::FieldLoopholeGet<T, I>{};
+    template <class... Lhs, class... Rhs>
+    Annotate<Lhs..., Rhs...> operator+(Annotate<Lhs...>, Annotate<Rhs...>);
+
+    // Annotations of raw members [begin, end) joined into one Annotate
+    template <class T, std::size_t begin, std::size_t... I>
+    auto JoinAnnotations(std::index_sequence<I...>) -> decltype((Annotate<>{} + ... + LoopholeGet<T, begin + I>{}));
+
+    template <class T, std::size_t I, class Field, class Annotations>
+    struct MakeDescriptor;
+
+    template <class T, std::size_t I, class Field, class... Annos>
+    struct MakeDescriptor<T, I, Field, Annotate<Annos...>> {
+        using Type = FieldDescriptor<T, I, Field, Annos...>;
+    };
+
+    inline constexpr std::size_t kMaxRawFields = 64;
+
+    // References to all raw members of an aggregate, annotations included
+    template <std::size_t N, class T>
+    requires (N <= kMaxRawFields)
+    constexpr auto TieRaw(T& object) noexcept {
+        if constexpr (N == 0) {
+            return std::tie();
+        } else if constexpr (N == 1) {
+            auto& [m0] = object;
+            return std::tie(m0);
+        } else if constexpr (N == 2) {
+            auto& [m0, m1] = object;
+            return std::tie(m0, m1);
+        } else if constexpr (N == 3) {
+            auto& [m0, m1, m2] = object;
+            return std::tie(m0, m1, m2);
+        } else if constexpr (N == 4) {
+            auto& [m0, m1, m2, m3] = object;
+            return std::tie(m0, m1, m2, m3);
+        } else if constexpr (N == 5) {
+            auto& [m0, m1, m2, m3, m4] = object;
+            return std::tie(m0, m1, m2, m3, m4);
+        } else if constexpr (N == 6) {
+            auto& [m0, m1, m2, m3, m4, m5] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5);
+        } else if constexpr (N == 7) {
+            auto& [m0, m1, m2, m3, m4, m5, m6] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6);
+        } else if constexpr (N == 8) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+        } else if constexpr (N == 9) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+        } else if constexpr (N == 10) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+        } else if constexpr (N == 11) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+        } else if constexpr (N == 12) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+        } else if constexpr (N == 13) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+        } else if constexpr (N == 14) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+        } else if constexpr (N == 15) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+        } else if constexpr (N == 16) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+        } else if constexpr (N == 17) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16);
+        } else if constexpr (N == 18) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17);
+        } else if constexpr (N == 19) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18);
+        } else if constexpr (N == 20) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19);
+        } else if constexpr (N == 21) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20);
+        } else if constexpr (N == 22) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21);
+        } else if constexpr (N == 23) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22);
+        } else if constexpr (N == 24) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23);
+        } else if constexpr (N == 25) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24);
+        } else if constexpr (N == 26) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25);
+        } else if constexpr (N == 27) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26);
+        } else if constexpr (N == 28) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27);
+        } else if constexpr (N == 29) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28);
+        } else if constexpr (N == 30) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29);
+        } else if constexpr (N == 31) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30);
+        } else if constexpr (N == 32) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31);
+        } else if constexpr (N == 33) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32);
+        } else if constexpr (N == 34) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33);
+        } else if constexpr (N == 35) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34);
+        } else if constexpr (N == 36) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35);
+        } else if constexpr (N == 37) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36);
+        } else if constexpr (N == 38) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37);
+        } else if constexpr (N == 39) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38);
+        } else if constexpr (N == 40) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39);
+        } else if constexpr (N == 41) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40);
+        } else if constexpr (N == 42) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41);
+        } else if constexpr (N == 43) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42);
+        } else if constexpr (N == 44) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43);
+        } else if constexpr (N == 45) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44);
+        } else if constexpr (N == 46) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45);
+        } else if constexpr (N == 47) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46);
+        } else if constexpr (N == 48) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47);
+        } else if constexpr (N == 49) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48);
+        } else if constexpr (N == 50) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49);
+        } else if constexpr (N == 51) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50);
+        } else if constexpr (N == 52) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51);
+        } else if constexpr (N == 53) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52);
+        } else if constexpr (N == 54) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53);
+        } else if constexpr (N == 55) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54);
+        } else if constexpr (N == 56) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55);
+        } else if constexpr (N == 57) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56);
+        } else if constexpr (N == 58) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57);
+        } else if constexpr (N == 59) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58);
+        } else if constexpr (N == 60) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59);
+        } else if constexpr (N == 61) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60);
+        } else if constexpr (N == 62) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61);
+        } else if constexpr (N == 63) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61, m62] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61, m62);
+        } else if constexpr (N == 64) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61, m62, m63] = object;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61, m62, m63);
+        }
     }
 
 };  // namespace detail
@@ -132,36 +359,142 @@ namespace detail {
 template <class T>
 struct Describe {
   private:
-    static constexpr std::size_t num_fields_with_annots = detail::CountRawFieldsImpl<T>(std::index_sequence<0>{});
+    static constexpr std::size_t num_fields_with_annots = detail::CountRawFields<T>();
 
-    template <std::size_t I, std::size_t RealIndex, typename... Annots, typename... NewAnnots>
-    static constexpr std::size_t AnnotateExpandHelper(Annotate<NewAnnots...>) {
-        return CountFieldsImpl<I, RealIndex, Annots..., NewAnnots...>();
+    // Initializing T from UbiqInitialize records the type of every raw member, then they can be read back
+    template <std::size_t... I>
+    static constexpr std::array<bool, sizeof...(I)> ProbeAnnotations(std::index_sequence<I...>) {
+        [[maybe_unused]] T unused_{detail::UbiqInitialize<T, I>{}...};
+        return {detail::IsAnnotate<detail::LoopholeGet<T, I>>...};
     }
-    
-    template <std::size_t I, std::size_t RealIndex = 0, typename... Annots>
-    static constexpr std::size_t CountFieldsImpl() {
-        if constexpr (I == num_fields_with_annots) {
-            return RealIndex;
+
+    static constexpr std::array<bool, num_fields_with_annots> is_annotation = ProbeAnnotations(std::make_index_sequence<num_fields_with_annots>());
+
+  public:
+    static constexpr std::size_t num_fields = [] {
+        std::size_t count = 0;
+        for (bool annotation : is_annotation) {
+            count += !annotation;
+        }
+        return count;
+    }();
+
+  private:
+    static constexpr std::array<std::size_t, num_fields> raw_indices = [] {
+        std::array<std::size_t, num_fields> result{};
+        std::size_t real = 0;
+        for (std::size_t i = 0; i < num_fields_with_annots; ++i) {
+            if (!is_annotation[i]) result[real++] = i;
+        }
+        return result;
+    }();
+
+    // Annotations of field I are the raw members between field I - 1 and field I
+    template <std::size_t I>
+    static constexpr std::size_t annotations_begin = I == 0 ? 0 : raw_indices[I - 1] + 1;
+
+  public:
+    template <std::size_t I>
+    requires (I < num_fields)
+    using Field = typename detail::MakeDescriptor<
+        T, I, detail::LoopholeGet<T, raw_indices[I]>,
+        decltype(detail::JoinAnnotations<T, annotations_begin<I>>(std::make_index_sequence<raw_indices[I] - annotations_begin<I>>()))>::Type;
+
+    // Position of field I among all members of T, annotations included
+    template <std::size_t I>
+    static constexpr std::size_t raw_index = raw_indices[I];
+
+    // Reference to field I of object
+    template <std::size_t I, class Object>
+    requires (std::same_as<std::remove_cvref_t<Object>, T> && I < num_fields)
+    // Up to kMaxRawFields members it goes through a structured binding and works in constant
+    // expressions; larger standard-layout types are addressed through the computed layout.
+    static constexpr auto& Get(Object& object) noexcept {
+        if constexpr (num_fields_with_annots <= detail::kMaxRawFields) {
+            return std::get<raw_index<I>>(detail::TieRaw<num_fields_with_annots>(object));
         } else {
-            if constexpr (detail::IsAnnotate<detail::LoopholeGet<T, I>>) {
-                return AnnotateExpandHelper<I + 1, RealIndex, Annots...>(detail::LoopholeGet<T, I>{});
-            } else {
-                [[maybe_unused]] detail::FieldLoopholeSet<T, RealIndex, FieldDescriptor<T, RealIndex, detail::LoopholeGet<T, I>, Annots...>> unused{};
-                return CountFieldsImpl<I + 1, RealIndex + 1>();
-            }
+            static_assert(layout_known,
+                          "Describe::Get: types with more than 64 members, annotations included, must be standard-layout");
+            using Member = std::conditional_t<std::is_const_v<Object>, const typename Field<I>::Type, typename Field<I>::Type>;
+            using Byte = std::conditional_t<std::is_const_v<Object>, const std::byte, std::byte>;
+            return *std::launder(reinterpret_cast<Member*>(reinterpret_cast<Byte*>(__builtin_addressof(object)) + offset<I>));
         }
     }
 
-    template <std::size_t... I>
-    static constexpr std::size_t CountFields(std::index_sequence<I...>) {
-        [[maybe_unused]] T unused_{detail::UbiqInitialize<T, I>{}...};
-        return CountFieldsImpl<0, 0>();
-    }
+  private:
+    // Members, annotations included, are placed at the next multiple of their alignment,
+    // as for any standard-layout aggregate
+    static constexpr std::array<std::size_t, num_fields_with_annots + 1> raw_offsets = [] {
+        std::array<std::size_t, num_fields_with_annots + 1> offsets{};
+        std::size_t end = 0;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((offsets[I] = (end + alignof(detail::LoopholeGet<T, I>) - 1) / alignof(detail::LoopholeGet<T, I>) * alignof(detail::LoopholeGet<T, I>),
+              end = offsets[I] + sizeof(detail::LoopholeGet<T, I>)), ...);
+        }(std::make_index_sequence<num_fields_with_annots>());
+        offsets[num_fields_with_annots] = end;
+        return offsets;
+    }();
 
   public:
-    static constexpr std::size_t num_fields = CountFields(std::make_index_sequence<num_fields_with_annots>());
-    
+    // Layout
+
+    // The computed layout reproduces sizeof(T). It does not for members with [[no_unique_address]]
+    // or types that are not standard-layout, offsets and padding must not be used then.
+    static constexpr bool layout_known =
+        std::is_standard_layout_v<T> && (raw_offsets[num_fields_with_annots] + alignof(T) - 1) / alignof(T) * alignof(T) == sizeof(T);
+
+    template <std::size_t I>
+    static constexpr std::size_t offset = raw_offsets[raw_index<I>];
+
     template <std::size_t I>
-    using Field = decltype(detail::ForceCalculation<T, I, num_fields>());
+    static constexpr std::size_t size = Field<I>::size;
+
+    template <std::size_t I>
+    static constexpr std::size_t alignment = Field<I>::alignment;
+
+    // padding[b] is true if byte b of T belongs to no field, bytes of annotation members are padding
+    static constexpr std::array<bool, sizeof(T)> padding = [] {
+        std::array<bool, sizeof(T)> result{};
+        result.fill(true);
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            auto cover = [&](std::size_t begin, std::size_t count) {
+                for (std::size_t b = begin; b < begin + count && b < sizeof(T); ++b) {
+                    result[b] = false;
+                }
+            };
+            (cover(offset<I>, size<I>), ...);
+        }(std::make_index_sequence<num_fields>());
+        return result;
+    }();
+
+    // For fields marked in `eligible`: the number of bytes of the run of adjacent eligible fields
+    // with no padding in between that starts at the field, 0 for fields inside a run and for other fields.
+    // Without a known layout every eligible field is a run of its own.
+    static constexpr std::array<std::size_t, num_fields> Runs(const std::array<bool, num_fields>& eligible) {
+        std::array<std::size_t, num_fields> sizes{};
+        std::array<std::size_t, num_fields> offsets{};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((sizes[I] = size<I>, offsets[I] = offset<I>), ...);
+        }(std::make_index_sequence<num_fields>());
+
+        auto continues = [&](std::size_t i) {
+            return layout_known && i > 0 && eligible[i] && eligible[i - 1] && offsets[i] == offsets[i - 1] + sizes[i - 1];
+        };
+        std::array<std::size_t, num_fields> runs{};
+        for (std::size_t i = 0; i < num_fields; ++i) {
+            if (!eligible[i] || continues(i)) continue;
+            std::size_t j = i + 1;
+            while (j < num_fields && continues(j)) ++j;
+            runs[i] = offsets[j - 1] + sizes[j - 1] - offsets[i];
+        }
+        return runs;
+    }
+
+    static constexpr std::size_t padding_bytes = [] {
+        std::size_t count = 0;
+        for (bool byte : padding) {
+            count += byte;
+        }
+        return count;
+    }();
 };
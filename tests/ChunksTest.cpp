@@ -0,0 +1,83 @@
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <Slice.hpp>
+#include <Span.hpp>
+
+#include "Check.hpp"
+
+// Element i of every chunk is base[first + i * stride], chunks start `step` elements apart
+template <class Chunks>
+void CheckChunks(const Chunks& chunks, const int* base, std::size_t count, std::size_t size,
+                 std::size_t step, std::ptrdiff_t stride) {
+  CHECK(chunks.Size() == count);
+  std::size_t index = 0;
+  for (auto chunk : chunks) {
+    CHECK(chunk.Size() == size);
+    for (std::size_t i = 0; i < size; ++i) {
+      CHECK(chunk[i] == base[(index * step + i) * stride]);
+    }
+    ++index;
+  }
+  CHECK(index == count);
+}
+
+void TestSpan() {
+  std::vector<int> data(10);
+  std::iota(data.begin(), data.end(), 0);
+
+  Span<int> span(data.data(), data.size());
+  CheckChunks(span.Chunks<4>(), data.data(), 2, 4, 4, 1);
+  CHECK(span.Chunks<4>().Remainder().Size() == 2);
+  CHECK(span.Chunks<4>().Remainder()[0] == 8);
+  CheckChunks(span.Chunks(3), data.data(), 3, 3, 3, 1);
+  CheckChunks(span.Windows<4>(), data.data(), 7, 4, 1, 1);
+
+  Span<int, 10> fixed(data.data(), data.size());
+  CheckChunks(fixed.Chunks<5>(), data.data(), 2, 5, 5, 1);
+  CHECK(fixed.Chunks<5>().Remainder().Size() == 0);
+}
+
+void TestDynamicSlice() {
+  std::vector<int> data(30);
+  std::iota(data.begin(), data.end(), 0);
+
+  Slice<int, std::dynamic_extent, dynamic_stride> slice(data.begin(), 10, 3);
+  CheckChunks(slice.Chunks<4>(), data.data(), 2, 4, 4, 3);
+  CHECK(slice.Chunks<4>().Remainder().Size() == 2);
+  CHECK(slice.Chunks<4>().Remainder()[1] == 27);
+  CheckChunks(slice.Chunks(3), data.data(), 3, 3, 3, 3);
+  CheckChunks(slice.Windows<4>(), data.data(), 7, 4, 1, 3);
+  CHECK(slice.Windows<11>().Size() == 0);
+}
+
+// Chunking a slice with a static extent goes through its dynamic-extent view
+void TestStaticSlice() {
+  std::array<int, 30> data{};
+  std::iota(data.begin(), data.end(), 0);
+
+  Slice<int, 10, 3> slice(data.begin(), 10, 3);
+  CheckChunks(slice.Chunks<4>(), data.data(), 2, 4, 4, 3);
+  CHECK(slice.Chunks<4>().Remainder().Size() == 2);
+  CHECK(slice.Chunks<4>().Remainder()[0] == 24);
+  CheckChunks(slice.Chunks(5), data.data(), 2, 5, 5, 3);
+  CheckChunks(slice.Windows<3>(), data.data(), 8, 3, 1, 3);
+
+  Slice<int, 10, 1> contiguous(data.begin(), 10, 1);
+  CheckChunks(contiguous.Chunks<2>(), data.data(), 5, 2, 2, 1);
+
+  Slice<int, std::dynamic_extent, 3> erased = slice;
+  CHECK(erased.Size() == 10);
+  CHECK(erased[9] == 27);
+
+  Slice<const int, 10, 3> constant = slice;
+  CHECK(constant[9] == 27);
+}
+
+int main() {
+  TestSpan();
+  TestDynamicSlice();
+  TestStaticSlice();
+}
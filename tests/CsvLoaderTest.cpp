@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <CsvLoader.hpp>
+
+#include "Check.hpp"
+
+enum class Side : std::uint8_t { Buy, Sell, Hold = 5 };
+
+struct Order {
+  std::uint64_t id;
+  char side;
+  double price;
+  std::int32_t quantity;
+};
+
+struct Instruction {
+  std::uint32_t id;
+  Side side;
+};
+
+// Names are looked up among the real enumerators only
+static_assert(detail::csv::Enumerators<Side>::size == 3);
+
+// Message of the error thrown while loading text, empty if it loads
+std::string LoadError(std::string_view text) {
+  SoAVector<Order> orders;
+  CsvLoader<Order> loader(orders);
+  try {
+    loader.Feed(Span<const char>(text.data(), text.size()));
+    loader.Finish();
+  } catch (const std::runtime_error& error) {
+    return error.what();
+  }
+  return "";
+}
+
+void TestLoad() {
+  SoAVector<Order> orders;
+  CsvLoader<Order> loader(orders, {.delimiter = ',', .header = true});
+  std::string_view text = "id,side,price,quantity\n1,B,10.5,100\r\n\n2,S,11,20";
+  loader.Feed(Span<const char>(text.data(), 20));
+  loader.Feed(Span<const char>(text.data() + 20, text.size() - 20));
+  loader.Finish();
+  CHECK(orders.Size() == 2);
+  CHECK(orders.Column<0>()[1] == 2);
+  CHECK(orders.Column<1>()[0] == 'B');
+  CHECK(orders.Column<2>()[0] == 10.5);
+  CHECK(orders.Column<3>()[1] == 20);
+}
+
+// Enumerators by name or by any value of the underlying type
+void TestEnum() {
+  SoAVector<Instruction> instructions;
+  CsvLoader<Instruction> loader(instructions);
+  std::string_view text = "1,Buy\n2,Hold\n3,Sell\n4,1\n5,7\n";
+  loader.Feed(Span<const char>(text.data(), text.size()));
+  loader.Finish();
+  CHECK(instructions.Size() == 5);
+  CHECK(instructions.Column<1>()[0] == Side::Buy);
+  CHECK(instructions.Column<1>()[1] == Side::Hold);
+  CHECK(instructions.Column<1>()[2] == Side::Sell);
+  CHECK(instructions.Column<1>()[3] == Side::Sell);
+  CHECK(static_cast<int>(instructions.Column<1>()[4]) == 7);
+
+  for (std::string_view bad : {"2,Bogus\n", "2,buy\n", "2,Side::Buy\n", "2,256\n", "2,\n"}) {
+    SoAVector<Instruction> rejected;
+    CsvLoader<Instruction> strict(rejected);
+    bool thrown = false;
+    try {
+      strict.Feed(Span<const char>(bad.data(), bad.size()));
+    } catch (const std::runtime_error& error) {
+      thrown = std::string_view(error.what()).find("line 1, field 2: malformed value") != std::string_view::npos;
+    }
+    CHECK(thrown);
+  }
+}
+
+// Lines and fields are both counted from 1
+void TestErrors() {
+  CHECK(LoadError("1,B,10,5\n") == "");
+  CHECK(LoadError("1,B,x,5\n") == "csv: line 1, field 3: malformed value 'x'");
+  CHECK(LoadError("1,B,10,5\nx,B,10,5\n") == "csv: line 2, field 1: malformed value 'x'");
+  CHECK(LoadError("1,B,10\n") == "csv: line 1, field 4: too few values");
+  CHECK(LoadError("1,B,10,5,6\n") == "csv: line 1, field 5: too many values");
+}
+
+int main() {
+  TestLoad();
+  TestEnum();
+  TestErrors();
+}
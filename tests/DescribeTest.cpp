@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <SoAVector.hpp>
+#include <reflect.hpp>
+
+#include "Check.hpp"
+
+struct Marker {};
+
+struct Point {
+  int x;
+  Annotate<Marker> _1;
+  double y;
+};
+
+// More members than the structured binding ladder covers, with padding and annotations
+struct Wide {
+  char f0;
+  double f1;
+  std::int32_t f2;
+  std::int16_t f3;
+  char f4;
+  double f5;
+  std::int32_t f6;
+  std::int16_t f7;
+  char f8;
+  double f9;
+  Annotate<Marker> _10;
+  std::int32_t f10;
+  std::int16_t f11;
+  char f12;
+  double f13;
+  std::int32_t f14;
+  std::int16_t f15;
+  char f16;
+  double f17;
+  std::int32_t f18;
+  std::int16_t f19;
+  char f20;
+  double f21;
+  std::int32_t f22;
+  std::int16_t f23;
+  char f24;
+  double f25;
+  std::int32_t f26;
+  std::int16_t f27;
+  char f28;
+  double f29;
+  std::int32_t f30;
+  std::int16_t f31;
+  char f32;
+  double f33;
+  std::int32_t f34;
+  std::int16_t f35;
+  char f36;
+  double f37;
+  std::int32_t f38;
+  std::int16_t f39;
+  char f40;
+  double f41;
+  std::int32_t f42;
+  std::int16_t f43;
+  char f44;
+  double f45;
+  std::int32_t f46;
+  std::int16_t f47;
+  char f48;
+  double f49;
+  Annotate<Marker> _50;
+  std::int32_t f50;
+  std::int16_t f51;
+  char f52;
+  double f53;
+  std::int32_t f54;
+  std::int16_t f55;
+  char f56;
+  double f57;
+  std::int32_t f58;
+  std::int16_t f59;
+  char f60;
+  double f61;
+  std::int32_t f62;
+  std::int16_t f63;
+  char f64;
+  double f65;
+  std::int32_t f66;
+  std::int16_t f67;
+  char f68;
+  double f69;
+  std::int32_t f70;
+  std::int16_t f71;
+  char f72;
+  double f73;
+  std::int32_t f74;
+  std::int16_t f75;
+  char f76;
+  double f77;
+  std::int32_t f78;
+  std::int16_t f79;
+  char f80;
+  double f81;
+  std::int32_t f82;
+  std::int16_t f83;
+  char f84;
+  double f85;
+  std::int32_t f86;
+  std::int16_t f87;
+  char f88;
+  double f89;
+  std::int32_t f90;
+  std::int16_t f91;
+  char f92;
+  double f93;
+  std::int32_t f94;
+  std::int16_t f95;
+  char f96;
+  double f97;
+  std::int32_t f98;
+  std::int16_t f99;
+};
+
+static_assert(Describe<Point>::num_fields == 2);
+static_assert(Describe<Wide>::num_fields == 100);
+static_assert(Describe<Wide>::layout_known);
+static_assert(std::is_same_v<Describe<Wide>::Field<50>::Type, std::int32_t>);
+static_assert(Describe<Wide>::Field<50>::has_annotation_class<Marker>);
+
+constexpr double PointY() {
+  Point point{1, {}, 2.5};
+  return Describe<Point>::Get<1>(point);
+}
+static_assert(PointY() == 2.5);
+
+void TestWideGet() {
+  Wide wide{};
+  Describe<Wide>::Get<0>(wide) = 'a';
+  Describe<Wide>::Get<49>(wide) = 4.5;
+  Describe<Wide>::Get<50>(wide) = 7;
+  Describe<Wide>::Get<99>(wide) = -3;
+  CHECK(wide.f0 == 'a');
+  CHECK(wide.f49 == 4.5);
+  CHECK(wide.f50 == 7);
+  CHECK(wide.f99 == -3);
+  CHECK(wide.f98 == 0);
+
+  const Wide& view = wide;
+  static_assert(std::is_same_v<decltype(Describe<Wide>::Get<99>(view)), const std::int16_t&>);
+  CHECK(&Describe<Wide>::Get<97>(view) == &wide.f97);
+}
+
+void TestWideContainer() {
+  SoAVector<Wide> rows;
+  for (int i = 0; i < 10; ++i) {
+    Wide wide{};
+    wide.f1 = i * 0.5;
+    wide.f99 = static_cast<std::int16_t>(i);
+    rows.PushBack(wide);
+  }
+  CHECK(rows.Column<1>()[4] == 2.0);
+  CHECK(rows.Column<99>()[9] == 9);
+  Wide copy = rows[7];
+  CHECK(copy.f99 == 7);
+}
+
+int main() {
+  TestWideGet();
+  TestWideContainer();
+}
@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <HotColdVector.hpp>
+
+#include "Check.hpp"
+#include "Tracked.hpp"
+
+struct Account {
+  Annotate<hot_cold::Hot> _1;
+  std::uint64_t id;
+  Annotate<hot_cold::Hot> _2;
+  double balance;
+  std::string owner;
+};
+
+struct Pair {
+  Tracked first;
+  Tracked second;
+};
+
+void TestRowAssignment() {
+  HotColdVector<Account> accounts;
+  for (std::uint64_t i = 0; i < 6; ++i) {
+    accounts.PushBack(Account{{}, i, {}, i * 10.0, "owner" + std::to_string(i)});
+  }
+
+  accounts[0] = accounts[5];
+  CHECK(accounts[0].Get<0>() == 5);
+  CHECK(accounts[0].Get<1>() == 50.0);
+  CHECK(accounts[0].Get<2>() == "owner5");
+  CHECK(accounts[5].Get<2>() == "owner5");
+
+  const HotColdVector<Account>& view = accounts;
+  accounts[1] = view[4];
+  CHECK(accounts[1].Get<0>() == 4);
+  CHECK(accounts[1].Get<2>() == "owner4");
+
+  auto row = accounts[2];
+  row = accounts[3];
+  CHECK(row.Index() == 2);
+  CHECK(accounts[2].Get<0>() == 3);
+}
+
+void TestPushBackThrows() {
+  Budget budget;
+  {
+    HotColdVector<Pair> pairs;
+    Pair pair{Tracked(budget, 1), Tracked(budget, 2)};
+    budget.copies_before_throw = 1;
+    bool thrown = false;
+    try {
+      pairs.PushBack(pair);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    budget.copies_before_throw = -1;
+    CHECK(thrown);
+    CHECK(pairs.Size() == 0);
+    CHECK(budget.live == 2);
+  }
+  CHECK(budget.live == 0);
+}
+
+void TestCopyThrows() {
+  Budget budget;
+  {
+    HotColdVector<Pair> pairs;
+    for (int i = 0; i < 3; ++i) {
+      pairs.PushBack(Pair{Tracked(budget, i), Tracked(budget, i)});
+    }
+    CHECK(budget.live == 6);
+
+    // Fails on the second field of the second row
+    budget.copies_before_throw = 3;
+    bool thrown = false;
+    try {
+      HotColdVector<Pair> copy(pairs);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    budget.copies_before_throw = -1;
+    CHECK(thrown);
+    CHECK(budget.live == 6);
+
+    HotColdVector<Pair> copy(pairs);
+    CHECK(copy.Size() == 3);
+    CHECK(copy[2].Get<1>().value == 2);
+  }
+  CHECK(budget.live == 0);
+}
+
+int main() {
+  TestRowAssignment();
+  TestPushBackThrows();
+  TestCopyThrows();
+}
@@ -0,0 +1,47 @@
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+#include <Slice.hpp>
+#include <SliceCopy.hpp>
+#include <Span.hpp>
+
+#include "Check.hpp"
+
+// Contiguous, statically and dynamically strided slices, both directions
+void TestCopies() {
+  std::array<int, 24> data{};
+  std::iota(data.begin(), data.end(), 0);
+  std::array<int, 8> buffer{};
+  Span<int> out(buffer.data(), buffer.size());
+
+  CopyTo(Slice<int>(data.begin(), 8, 1), out);
+  CHECK(buffer[7] == 7);
+  CopyTo(Slice<int, std::dynamic_extent, 3>(data.begin(), 8, 3), out);
+  CHECK(buffer[7] == 21);
+  CopyTo(Slice<int, std::dynamic_extent, dynamic_stride>(data.begin(), 8, 2), out);
+  CHECK(buffer[7] == 14);
+
+  std::array<int, 24> target{};
+  CopyFrom(Slice<int, std::dynamic_extent, dynamic_stride>(target.begin(), 8, 3), Span<const int>(buffer.data(), buffer.size()));
+  CHECK(target[21] == 14);
+  CHECK(target[20] == 0);
+  CopyFrom(Slice<int>(target.begin(), 8, 1), Span<const int>(buffer.data(), buffer.size()));
+  CHECK(target[1] == 2);
+}
+
+// Default-constructed views hold null pointers; the test runs under UBSan where available
+void TestEmpty() {
+  Slice<int> slice;
+  Span<int> span;
+  CopyTo(slice, span);
+  CopyFrom(slice, Span<const int>());
+  Slice<int, std::dynamic_extent, dynamic_stride> strided;
+  CopyTo(strided, span);
+  CopyFrom(strided, Span<const int>());
+}
+
+int main() {
+  TestCopies();
+  TestEmpty();
+}
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <SoAVector.hpp>
+
+#include "Check.hpp"
+#include "Tracked.hpp"
+
+struct Quote {};
+
+struct Order {
+  std::uint64_t id;
+  Annotate<soa::Group<Quote>> _1;
+  double price;
+  Annotate<soa::Group<Quote>> _2;
+  std::uint32_t quantity;
+  Annotate<soa::Skip> _3;
+  std::string comment;
+};
+
+// One column per field
+struct Pair {
+  Tracked first;
+  Tracked second;
+};
+
+void TestRowAssignment() {
+  SoAVector<Order> orders;
+  for (std::uint32_t i = 0; i < 6; ++i) {
+    orders.PushBack(Order{i, {}, i * 10.0, {}, i * 100, {}, "comment"});
+  }
+
+  orders[0] = orders[5];
+  CHECK(orders[0].Get<0>() == 5);
+  CHECK(orders[0].Get<1>() == 50.0);
+  CHECK(orders[0].Get<2>() == 500);
+  CHECK(orders[5].Get<0>() == 5);
+
+  const SoAVector<Order>& view = orders;
+  orders[1] = view[4];
+  CHECK(orders[1].Get<0>() == 4);
+  CHECK(orders[1].Get<2>() == 400);
+
+  auto row = orders[2];
+  row = orders[3];
+  CHECK(row.Index() == 2);
+  CHECK(orders[2].Get<1>() == 30.0);
+}
+
+void TestPushBackThrows() {
+  Budget budget;
+  {
+    SoAVector<Pair> pairs;
+    Pair pair{Tracked(budget, 1), Tracked(budget, 2)};
+    budget.copies_before_throw = 1;
+    bool thrown = false;
+    try {
+      pairs.PushBack(pair);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    budget.copies_before_throw = -1;
+    CHECK(thrown);
+    CHECK(pairs.Size() == 0);
+    CHECK(budget.live == 2);
+
+    pairs.PushBack(pair);
+    CHECK(pairs.Size() == 1);
+    CHECK(budget.live == 4);
+  }
+  CHECK(budget.live == 0);
+}
+
+void TestCopyThrows() {
+  Budget budget;
+  {
+    SoAVector<Pair> pairs;
+    for (int i = 0; i < 3; ++i) {
+      pairs.PushBack(Pair{Tracked(budget, i), Tracked(budget, i)});
+    }
+    CHECK(budget.live == 6);
+
+    // Fails on the second column of the second row
+    budget.copies_before_throw = 3;
+    bool thrown = false;
+    try {
+      SoAVector<Pair> copy(pairs);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    budget.copies_before_throw = -1;
+    CHECK(thrown);
+    CHECK(budget.live == 6);
+
+    SoAVector<Pair> copy(pairs);
+    CHECK(copy.Size() == 3);
+    CHECK(copy[2].Get<1>().value == 2);
+  }
+  CHECK(budget.live == 0);
+}
+
+int main() {
+  TestRowAssignment();
+  TestPushBackThrows();
+  TestCopyThrows();
+}
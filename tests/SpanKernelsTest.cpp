@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <AlignedSpan.hpp>
+#include <Span.hpp>
+#include <SpanKernels.hpp>
+
+#include "Check.hpp"
+
+// Every kernel against the scalar loop it replaces. Values are small integers,
+// so floating point sums are exact in any order.
+
+template <typename T>
+std::vector<T> MakeData(std::size_t size) {
+  std::vector<T> data(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<T>(static_cast<int>((i * 7 + 3) % 13) - 6);
+  }
+  return data;
+}
+
+template <typename S, typename T>
+void CheckKernels(const S& span, const T* data, std::size_t size) {
+  T sum{};
+  for (std::size_t i = 0; i < size; ++i) {
+    sum = static_cast<T>(sum + data[i]);
+  }
+  CHECK(Sum(span) == sum);
+
+  if (size != 0) {
+    CHECK(Min(span) == *std::min_element(data, data + size));
+    CHECK(Max(span) == *std::max_element(data, data + size));
+  }
+
+  for (T value : {T(-6), T(0), T(5), T(100)}) {
+    CHECK(Find(span, value) == static_cast<std::size_t>(std::find(data, data + size, value) - data));
+    CHECK(Count(span, value) == static_cast<std::size_t>(std::count(data, data + size, value)));
+  }
+}
+
+// Dynamic extents, every size around the vector widths and every misalignment of the start
+template <typename T>
+void TestDynamic() {
+  std::vector<T> data = MakeData<T>(300);
+  for (std::size_t offset = 0; offset < 4; ++offset) {
+    for (std::size_t size = 0; size + offset <= data.size(); size += size < 80 ? 1 : 37) {
+      const T* first = data.data() + offset;
+      CheckKernels(Span<const T>(first, size), first, size);
+    }
+  }
+}
+
+// Unrolled up to kUnrollLimit, vector loops above it
+template <typename T, std::size_t extent>
+void TestFixed() {
+  std::vector<T> data = MakeData<T>(extent);
+  CheckKernels(Span<const T, extent>(data.data(), extent), data.data(), extent);
+}
+
+template <typename T>
+void TestAligned() {
+  alignas(32) static T data[200];
+  std::vector<T> values = MakeData<T>(200);
+  std::copy(values.begin(), values.end(), data);
+  for (std::size_t size : {0, 1, 31, 64, 65, 200}) {
+    CheckKernels(AlignedSpan<const T, std::dynamic_extent, 32>(data, size), data, size);
+  }
+}
+
+// Lane counters of narrow types are flushed before they overflow
+void TestLongCount() {
+  std::vector<std::int8_t> data(100000, 1);
+  data[500] = 2;
+  Span<const std::int8_t> span(data.data(), data.size());
+  CHECK(Count(span, std::int8_t{1}) == data.size() - 1);
+  CHECK(Find(span, std::int8_t{2}) == 500);
+  CHECK(Sum(span) == static_cast<std::int8_t>(data.size() + 1));
+}
+
+template <typename T>
+void TestType() {
+  TestDynamic<T>();
+  TestFixed<T, 1>();
+  TestFixed<T, 7>();
+  TestFixed<T, 64>();
+  TestFixed<T, 65>();
+  TestFixed<T, 257>();
+  TestAligned<T>();
+}
+
+int main() {
+  TestType<std::int8_t>();
+  TestType<std::uint8_t>();
+  TestType<std::int16_t>();
+  TestType<std::int32_t>();
+  TestType<std::uint32_t>();
+  TestType<std::int64_t>();
+  TestType<float>();
+  TestType<double>();
+  TestLongCount();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdexcept>
+
+// Live objects of Tracked, and how many more copies succeed before one throws
+struct Budget {
+  int live = 0;
+  int copies_before_throw = -1;
+};
+
+// Reports to its budget; Describe builds default-constructed fields at compile time,
+// so a Tracked without a budget stays a literal type
+struct Tracked {
+  Budget* budget = nullptr;
+  int value = 0;
+
+  constexpr Tracked() = default;
+  constexpr Tracked(Budget& budget, int value) : budget(&budget), value(value) { ++budget.live; }
+  constexpr Tracked(const Tracked& other) : budget(other.budget), value(other.value) {
+    if (budget != nullptr) {
+      if (budget->copies_before_throw == 0) {
+        throw std::runtime_error("copy");
+      }
+      --budget->copies_before_throw;
+      ++budget->live;
+    }
+  }
+  constexpr Tracked& operator=(const Tracked&) = default;
+  constexpr ~Tracked() {
+    if (budget != nullptr) {
+      --budget->live;
+    }
+  }
+};